@@ -0,0 +1,106 @@
+package meow
+
+import (
+	"encoding/binary"
+	"encoding/json"
+	"fmt"
+	"math"
+)
+
+// arena holds a merged meow in the layout of a snapshot, see snapshot.go: a single string
+// of all keys and string values, and flat tables of nodes and entries that refer to each
+// other by index. The tables hold no pointers, so the garbage collector never scans them,
+// whatever the size of the meow. The entries of an object are sorted by key and looked up
+// by binary search. LoadSnapshot serves an arena over the tables of a snapshot file.
+type arena struct {
+	snapshotDecoder
+}
+
+// newArena stores m in an arena. Values kept undecoded are decoded first.
+func newArena(m map[string]any) (*arena, error) {
+	e := &snapshotEncoder{offsets: make(map[string]uint32)}
+	if err := e.value(m); err != nil {
+		return nil, err
+	}
+	if e.strings.Len() > math.MaxUint32 || len(e.nodes)/snapshotNode > math.MaxUint32 {
+		return nil, fmt.Errorf("meow too large for an arena")
+	}
+	return &arena{snapshotDecoder{strings: e.strings.String(), nodes: e.nodes, entries: e.entries}}, nil
+}
+
+func (a *arena) node(n int) (kind byte, x uint32, y uint64) {
+	node := a.nodes[n*snapshotNode:]
+	return node[0], binary.LittleEndian.Uint32(node[4:]), binary.LittleEndian.Uint64(node[8:])
+}
+
+// find returns the node of a sequence of keys, the merged object for no key.
+func (a *arena) find(key []string) (int, bool) {
+	n := 0
+	for _, k := range key {
+		var ok bool
+		if n, ok = a.child(n, k); !ok {
+			return 0, false
+		}
+	}
+	return n, true
+}
+
+// child returns the node of the member k of the object node n.
+func (a *arena) child(n int, k string) (int, bool) {
+	kind, count, first := a.node(n)
+	if kind != nodeObject {
+		return 0, false
+	}
+	lo, hi := int(first), int(first)+int(count)
+	for lo < hi {
+		mid := int(uint(lo+hi) >> 1)
+		if a.key(mid) < k {
+			lo = mid + 1
+		} else {
+			hi = mid
+		}
+	}
+	if lo == int(first)+int(count) || a.key(lo) != k {
+		return 0, false
+	}
+	return a.entryNode(lo), true
+}
+
+// entryNode returns the node of an entry.
+func (a *arena) entryNode(entry int) int {
+	return int(binary.LittleEndian.Uint32(a.entries[entry*snapshotEntry+8:]))
+}
+
+func (a *arena) key(entry int) string {
+	e := a.entries[entry*snapshotEntry:]
+	off := binary.LittleEndian.Uint32(e)
+	return a.strings[off : off+binary.LittleEndian.Uint32(e[4:])]
+}
+
+// len returns the number of members of the merged object.
+func (a *arena) len() int {
+	_, count, _ := a.node(0)
+	return int(count)
+}
+
+// get returns the value of node n. Objects and arrays are built anew on every call.
+func (a *arena) get(n int) any {
+	v, _ := a.value(n)
+	return v
+}
+
+// scalar returns the conversions of node n without building a value.
+func (a *arena) scalar(n int) scalar {
+	kind, x, y := a.node(n)
+	switch kind {
+	case nodeBool:
+		return newScalar(x != 0)
+	case nodeNumber:
+		return newScalar(math.Float64frombits(y))
+	case nodeString:
+		return newScalar(a.strings[y : y+uint64(x)])
+	case nodeNumberText:
+		return newScalar(json.Number(a.strings[y : y+uint64(x)]))
+	}
+	return scalar{}
+}
@@ -0,0 +1,84 @@
+package meow
+
+import (
+	"bytes"
+	"reflect"
+	"runtime"
+	"strings"
+	"testing"
+)
+
+func TestArena(t *testing.T) {
+
+	for _, doc := range [][]byte{[]byte(body), synthetic(2000, 40)} {
+		appid := "chess"
+		if !bytes.Contains(doc, []byte(`"chess"`)) {
+			appid = "app"
+		}
+		for _, opts := range [][]Option{nil, {WithNumbers()}, {WithLazy(), WithDeepMerge()}, {WithIndex()}} {
+			expected, err := LoadReader(appid, bytes.NewReader(doc), opts...)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			meow, err := LoadReader(appid, bytes.NewReader(doc), append(opts, WithArena())...)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			if meow.arena == nil || meow.meow != nil {
+				t.Fatalf("Error: %d options: not stored in an arena", len(opts))
+			}
+			if !reflect.DeepEqual(meow.Value(), expected.Value()) {
+				t.Errorf("Error: %d options: results differ", len(opts))
+			}
+			for k, v := range expected.root() {
+				if !meow.Exists(k) || !reflect.DeepEqual(meow.Value(k), v) {
+					t.Errorf("Error: %d options: `%s`: found %v, expected %v", len(opts), k, meow.Value(k), v)
+				}
+				if sub, ok := v.(map[string]any); ok {
+					for kk, vv := range sub {
+						if !reflect.DeepEqual(meow.Value(k, kk), vv) || Get[string](meow, k, kk) != Get[string](expected, k, kk) {
+							t.Errorf("Error: %d options: `%s.%s`: found %v, expected %v", len(opts), k, kk, meow.Value(k, kk), vv)
+						}
+					}
+				}
+			}
+			for _, key := range [][]string{{"missing"}, {"g1", "missing"}, {"key-test1", "x"}, {"", ""}} {
+				if meow.Exists(key...) || meow.Value(key...) != nil {
+					t.Errorf("Error: %d options: %v exists", len(opts), key)
+				}
+			}
+			if len(Diff(expected, meow)) != 0 {
+				t.Errorf("Error: %d options: found %v", len(opts), Diff(expected, meow))
+			}
+		}
+	}
+
+	meow, err := LoadReader("chess", strings.NewReader(body), WithArena())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if n := testing.AllocsPerRun(100, func() { Get[string](meow, "g1", "a1") }); n != 0 {
+		t.Errorf("Error: %v allocations", n)
+	}
+}
+
+func BenchmarkArenaHeap(b *testing.B) {
+	data := synthetic(100000, 50)
+	for _, opts := range [][]Option{nil, {WithArena()}} {
+		b.Run(map[bool]string{false: "maps", true: "arena"}[len(opts) > 0], func(b *testing.B) {
+			var meow *Meow
+			for i := 0; i < b.N; i++ {
+				var err error
+				if meow, err = LoadReader("app", bytes.NewReader(data), opts...); err != nil {
+					b.Fatal(err)
+				}
+			}
+			b.StopTimer()
+			runtime.GC()
+			var m runtime.MemStats
+			runtime.ReadMemStats(&m)
+			b.ReportMetric(float64(m.HeapAlloc)/(1<<20), "heap-MB")
+			runtime.KeepAlive(meow)
+		})
+	}
+}
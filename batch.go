@@ -0,0 +1,128 @@
+package meow
+
+// Batch is a list of sequences of keys compiled to be read together, see Meow.Read. The
+// sequences are arranged in a tree of their common prefixes, so a prefix shared by several
+// sequences, `db` and `db.pool` for `db.pool.min` and `db.pool.max`, is looked up once per
+// read. A Batch does not depend on a meow and can be read from any of them.
+type Batch struct {
+	size  int
+	nodes []batchNode
+	keys  [][]string
+}
+
+type batchNode struct {
+	key      string
+	children []int
+	paths    []int
+}
+
+// CompileBatch compiles sequences of keys for Meow.Read.
+func CompileBatch(keys ...[]string) *Batch {
+	b := &Batch{size: len(keys), nodes: make([]batchNode, 1)}
+	for i, key := range keys {
+		b.keys = append(b.keys, append([]string(nil), key...))
+		n := 0
+	next:
+		for _, k := range key {
+			for _, c := range b.nodes[n].children {
+				if b.nodes[c].key == k {
+					n = c
+					continue next
+				}
+			}
+			b.nodes = append(b.nodes, batchNode{key: k})
+			b.nodes[n].children = append(b.nodes[n].children, len(b.nodes)-1)
+			n = len(b.nodes) - 1
+		}
+		b.nodes[n].paths = append(b.nodes[n].paths, i)
+	}
+	return b
+}
+
+// Len returns the number of sequences of keys of the batch.
+func (b *Batch) Len() int {
+	return b.size
+}
+
+// Read stores the value of every sequence of keys of b into values, in the order they were
+// compiled, nil for the sequences that are not defined, and returns the number of defined
+// sequences. values must hold at least b.Len() elements. Read does not allocate, except
+// with WithArena where the values are built like with Value.
+func (meow *Meow) Read(b *Batch, values []any) int {
+	if b.size == 0 {
+		return 0
+	}
+	_ = values[b.size-1]
+	found := 0
+	if meow.overlay != nil {
+		for i, key := range b.keys {
+			var ok bool
+			if len(key) == 0 {
+				values[i], ok = meow.root(), true
+			} else {
+				values[i], ok = meow.lookup(key)
+			}
+			if ok {
+				found++
+			}
+		}
+		return found
+	}
+	root := &b.nodes[0]
+	if len(root.paths) > 0 {
+		found += b.store(root, meow.Value(), true, values)
+	}
+	if meow.arena != nil {
+		for _, c := range root.children {
+			n, ok := meow.arena.child(0, b.nodes[c].key)
+			found += b.readArena(meow.arena, c, n, ok, values)
+		}
+		return found
+	}
+	for _, c := range root.children {
+		v, ok := meow.meow[b.nodes[c].key]
+		found += b.read(c, resolve(v), ok, values)
+	}
+	return found
+}
+
+func (b *Batch) read(n int, v any, ok bool, values []any) int {
+	node := &b.nodes[n]
+	found := b.store(node, v, ok, values)
+	obj, _ := v.(map[string]any)
+	for _, c := range node.children {
+		cv, cok := obj[b.nodes[c].key]
+		found += b.read(c, cv, cok, values)
+	}
+	return found
+}
+
+func (b *Batch) readArena(a *arena, n int, an int, ok bool, values []any) int {
+	node := &b.nodes[n]
+	var v any
+	if ok && len(node.paths) > 0 {
+		v = a.get(an)
+	}
+	found := b.store(node, v, ok, values)
+	for _, c := range node.children {
+		cn, cok := 0, false
+		if ok {
+			cn, cok = a.child(an, b.nodes[c].key)
+		}
+		found += b.readArena(a, c, cn, cok, values)
+	}
+	return found
+}
+
+func (b *Batch) store(node *batchNode, v any, ok bool, values []any) int {
+	if !ok {
+		v = nil
+	}
+	for _, i := range node.paths {
+		values[i] = v
+	}
+	if ok {
+		return len(node.paths)
+	}
+	return 0
+}
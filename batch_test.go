@@ -0,0 +1,75 @@
+package meow
+
+import (
+	"reflect"
+	"strings"
+	"testing"
+)
+
+func TestBatch(t *testing.T) {
+
+	keys := [][]string{
+		{"g1", "a1"}, {"g1", "b1"}, {"g1"}, {"key-test1"}, {"missing"}, {"g1", "missing"},
+		{"key-test1", "x"}, {"g1", "a1"}, {},
+	}
+	b := CompileBatch(keys...)
+	if b.Len() != len(keys) {
+		t.Errorf("Error: found %d keys", b.Len())
+	}
+	for _, opts := range [][]Option{nil, {WithLazy()}, {WithIndex()}, {WithArena()}} {
+		meow, err := LoadReader("chess", strings.NewReader(body), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		values := make([]any, b.Len())
+		found := meow.Read(b, values)
+		expected := 0
+		for i, key := range keys {
+			if meow.Exists(key...) {
+				expected++
+			}
+			if !reflect.DeepEqual(values[i], meow.Value(key...)) {
+				t.Errorf("Error: %d options: %v: found %v, expected %v", len(opts), key, values[i], meow.Value(key...))
+			}
+		}
+		if found != expected {
+			t.Errorf("Error: %d options: found %d, expected %d", len(opts), found, expected)
+		}
+	}
+
+	meow, err := LoadReader("chess", strings.NewReader(body))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	values := make([]any, b.Len())
+	if n := testing.AllocsPerRun(100, func() { meow.Read(b, values) }); n != 0 {
+		t.Errorf("Error: %v allocations", n)
+	}
+	if CompileBatch().Len() != 0 || meow.Read(CompileBatch(), nil) != 0 {
+		t.Errorf("Error: empty batch")
+	}
+}
+
+func BenchmarkBatch(b *testing.B) {
+	meow, err := LoadReader("chess", strings.NewReader(body))
+	if err != nil {
+		b.Fatal(err)
+	}
+	keys := [][]string{{"g1", "a1"}, {"g1", "b1"}, {"g1", "c1"}, {"g1", "d1"}, {"key-test1"}, {"key-test2"}}
+	b.Run("values", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			for _, key := range keys {
+				meow.Value(key...)
+			}
+		}
+	})
+	b.Run("batch", func(b *testing.B) {
+		batch := CompileBatch(keys...)
+		values := make([]any, batch.Len())
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			meow.Read(batch, values)
+		}
+	})
+}
@@ -0,0 +1,210 @@
+package meow
+
+import (
+	"bytes"
+	"encoding/json"
+	"fmt"
+	"strings"
+	"testing"
+)
+
+// synthetic builds a registry for the application "app" with about keys keys spread over
+// layers scored layers. Every layer also overrides a few keys shared by all layers, and
+// half of the keys are nested one level down under groups of ten.
+func synthetic(keys int, layers int) []byte {
+	doc := make(map[string]any, layers+2)
+	per := keys / layers
+	if per == 0 {
+		per = 1
+	}
+	for l := 0; l < layers; l++ {
+		name := fmt.Sprintf("layer%d", l)
+		if l == layers-1 {
+			name = "app"
+		}
+		mw := map[string]any{"meow-score": l}
+		for i := 0; i < per; i++ {
+			k := fmt.Sprintf("k%d_%d", l, i)
+			if i%2 == 0 {
+				mw[k] = fmt.Sprintf("value %d %d", l, i)
+				continue
+			}
+			g, ok := mw[fmt.Sprintf("g%d_%d", l, i/20)].(map[string]any)
+			if !ok {
+				g = make(map[string]any)
+				mw[fmt.Sprintf("g%d_%d", l, i/20)] = g
+			}
+			g[k] = i
+		}
+		for i := 0; i < 4; i++ {
+			mw[fmt.Sprintf("shared%d", i)] = l
+		}
+		doc[name] = mw
+	}
+	doc["unscored"] = map[string]any{"a": []any{1, 2, 3}}
+	data, err := json.Marshal(doc)
+	if err != nil {
+		panic(err)
+	}
+	return data
+}
+
+// lookupMeow is the registry of the lookup benchmarks, fastMeow the same with all the
+// lookup structures built.
+var lookupMeow, fastMeow = lookupBody(), lookupBody(WithIndex(), WithViews())
+
+func lookupBody(opts ...Option) *Meow {
+	meow, err := LoadReader("chess", strings.NewReader(strings.Replace(body, `"int": 1,`, `"int": 1, "db": {"pool": {"max": 10, "name": "main"}, "limits": {"min": 1, "max": 10}},`, 1)), opts...)
+	if err != nil {
+		panic(err)
+	}
+	return meow
+}
+
+func BenchmarkLoadReader(b *testing.B) {
+	for _, keys := range []int{10, 1000, 100000} {
+		for _, layers := range []int{2, 50, 500} {
+			data := synthetic(keys, layers)
+			b.Run(fmt.Sprintf("keys=%d/layers=%d", keys, layers), func(b *testing.B) {
+				b.SetBytes(int64(len(data)))
+				b.ReportAllocs()
+				for i := 0; i < b.N; i++ {
+					if _, err := LoadReader("app", bytes.NewReader(data)); err != nil {
+						b.Fatal(err)
+					}
+				}
+			})
+		}
+	}
+}
+
+func BenchmarkLoadReaderLazy(b *testing.B) {
+	data := synthetic(100000, 50)
+	for _, lazy := range []bool{false, true} {
+		b.Run(fmt.Sprintf("lazy=%t", lazy), func(b *testing.B) {
+			var opts []Option
+			if lazy {
+				opts = append(opts, WithLazy())
+			}
+			b.SetBytes(int64(len(data)))
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				meow, err := LoadReader("app", bytes.NewReader(data), opts...)
+				if err != nil {
+					b.Fatal(err)
+				}
+				_ = meow.ValueString("k49_0")
+			}
+		})
+	}
+}
+
+func BenchmarkDecoder(b *testing.B) {
+	data := synthetic(100000, 50)
+	for _, d := range []Decoder{StdDecoder{}, FastDecoder{}} {
+		b.Run(fmt.Sprintf("decode/%T", d), func(b *testing.B) {
+			b.SetBytes(int64(len(data)))
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := d.Decode(data, false); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		b.Run(fmt.Sprintf("load/%T", d), func(b *testing.B) {
+			b.SetBytes(int64(len(data)))
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := LoadReader("app", bytes.NewReader(data), WithDecoder(d)); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+func BenchmarkValue(b *testing.B) {
+	b.Run("single", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_ = lookupMeow.Value("string")
+		}
+	})
+	b.Run("multi", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_ = lookupMeow.Value("db", "pool", "max")
+		}
+	})
+	b.Run("exists", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_ = lookupMeow.Exists("db", "pool", "max")
+		}
+	})
+	b.Run("multi-index", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_ = fastMeow.Value("db", "pool", "max")
+		}
+	})
+	b.Run("key", func(b *testing.B) {
+		k := lookupMeow.Compile("db", "pool", "max")
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_ = k.Value()
+		}
+	})
+}
+
+func BenchmarkTyped(b *testing.B) {
+	helpers := []struct {
+		name string
+		fn   func()
+	}{
+		{"ValueString", func() { _ = lookupMeow.ValueString("db", "pool", "name") }},
+		{"ValueInt", func() { _ = lookupMeow.ValueInt("db", "pool", "max") }},
+		{"ValueStringMap", func() { _ = lookupMeow.ValueStringMap("map-string") }},
+		{"ValueStringSlice", func() { _ = lookupMeow.ValueStringSlice("slice-string") }},
+		{"ValueIntMap", func() { _ = lookupMeow.ValueIntMap("db", "limits") }},
+		{"ValueIntSlice", func() { _ = lookupMeow.ValueIntSlice("slice-int") }},
+	}
+	for _, h := range helpers {
+		b.Run(h.name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				h.fn()
+			}
+		})
+	}
+	b.Run("ValueStringMap-views", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			_ = fastMeow.ValueStringMap("map-string")
+		}
+	})
+}
+
+func BenchmarkValueParallel(b *testing.B) {
+	b.ReportAllocs()
+	b.RunParallel(func(pb *testing.PB) {
+		for pb.Next() {
+			_ = lookupMeow.ValueString("db", "pool", "name")
+		}
+	})
+}
+
+func BenchmarkLoadReaderParallel(b *testing.B) {
+	data := synthetic(100000, 50)
+	for _, workers := range []int{1, 4, 16} {
+		b.Run(fmt.Sprintf("workers=%d", workers), func(b *testing.B) {
+			b.SetBytes(int64(len(data)))
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := LoadReader("app", bytes.NewReader(data), WithParallel(workers)); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
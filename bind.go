@@ -0,0 +1,323 @@
+package meow
+
+import (
+	"encoding/json"
+	"fmt"
+	"math"
+	"reflect"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+)
+
+// Binder is implemented by the structs with a decoder generated by cmd/meowbind.
+type Binder interface {
+	BindMeow(meow *Meow) error
+}
+
+// Bind fills the struct pointed to by v from the meow in one pass. A field is bound from the
+// keys in its `meow` tag, a dot separated sequence relative to the enclosing struct, or from
+// its name without a tag; a tag of "-" skips the field. Nested structs are bound from the
+// object at their keys, embedded structs without a tag from the enclosing object. Keys that
+// are not defined or null leave their field untouched.
+//
+// The supported field types are string, bool, the integer and float types, time.Duration
+// parsed from a string, structs, slices and string keyed maps of those, and any for the
+// value as is. A value of another type makes Bind fail with an error naming its keys. When
+// v implements Binder, its generated decoder is used instead of reflection.
+func (meow *Meow) Bind(v any) error {
+	if b, ok := v.(Binder); ok {
+		return b.BindMeow(meow)
+	}
+	rv := reflect.ValueOf(v)
+	if rv.Kind() != reflect.Pointer || rv.IsNil() || rv.Elem().Kind() != reflect.Struct {
+		return fmt.Errorf("cannot bind meow to %T: not a pointer to a struct", v)
+	}
+	return bindStruct(meow.root(), "", rv.Elem())
+}
+
+type bindField struct {
+	index    int
+	tag      string
+	key      []string
+	embedded bool
+}
+
+var bindPlans sync.Map
+
+// bindPlan returns the bound fields of a struct type, computed once per type.
+func bindPlan(t reflect.Type) []bindField {
+	if plan, ok := bindPlans.Load(t); ok {
+		return plan.([]bindField)
+	}
+	var plan []bindField
+	for i := 0; i < t.NumField(); i++ {
+		f := t.Field(i)
+		tag, tagged := f.Tag.Lookup("meow")
+		if tag == "-" {
+			continue
+		}
+		if f.Anonymous && !tagged && f.Type.Kind() == reflect.Struct {
+			plan = append(plan, bindField{index: i, embedded: true})
+			continue
+		}
+		if !f.IsExported() {
+			continue
+		}
+		if tag == "" {
+			tag = f.Name
+		}
+		plan = append(plan, bindField{index: i, tag: tag, key: strings.Split(tag, ".")})
+	}
+	bindPlans.Store(t, plan)
+	return plan
+}
+
+func bindStruct(obj map[string]any, prefix string, rv reflect.Value) error {
+	for _, f := range bindPlan(rv.Type()) {
+		fv := rv.Field(f.index)
+		if f.embedded {
+			if err := bindStruct(obj, prefix, fv); err != nil {
+				return err
+			}
+			continue
+		}
+		v, ok := bindLookup(obj, f.key...)
+		if !ok {
+			continue
+		}
+		if err := bindValue(fv, v, prefix, f.tag); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+var durationType = reflect.TypeOf(time.Duration(0))
+
+// bindValue converts v into dst. The keys of v are prefix and key, joined only when needed.
+func bindValue(dst reflect.Value, v any, prefix string, key string) error {
+	if v == nil {
+		return nil
+	}
+	t := dst.Type()
+	ok := false
+	switch {
+	case t == durationType:
+		var d time.Duration
+		if d, ok = bindDuration(v); ok {
+			dst.SetInt(int64(d))
+		}
+	case t.Kind() == reflect.String:
+		var s string
+		if s, ok = bindString(v); ok {
+			dst.SetString(s)
+		}
+	case t.Kind() == reflect.Bool:
+		var b bool
+		if b, ok = bindBool(v); ok {
+			dst.SetBool(b)
+		}
+	case t.Kind() >= reflect.Int && t.Kind() <= reflect.Int64:
+		var a int64
+		if a, ok = bindInt(v, t.Bits()); ok {
+			dst.SetInt(a)
+		}
+	case t.Kind() >= reflect.Uint && t.Kind() <= reflect.Uintptr:
+		var a uint64
+		if a, ok = bindUint(v, t.Bits()); ok {
+			dst.SetUint(a)
+		}
+	case t.Kind() == reflect.Float32 || t.Kind() == reflect.Float64:
+		var a float64
+		if a, ok = bindFloat(v, t.Bits()); ok {
+			dst.SetFloat(a)
+		}
+	case t.Kind() == reflect.Interface && t.NumMethod() == 0:
+		dst.Set(reflect.ValueOf(v))
+		ok = true
+	case t.Kind() == reflect.Struct:
+		var obj map[string]any
+		if obj, ok = bindObject(v); ok {
+			return bindStruct(obj, bindPath(prefix, key), dst)
+		}
+	case t.Kind() == reflect.Slice:
+		var a []any
+		if a, ok = bindArray(v); ok {
+			path := bindPath(prefix, key)
+			s := reflect.MakeSlice(t, len(a), len(a))
+			for i, e := range a {
+				if err := bindValue(s.Index(i), e, path, "[]"); err != nil {
+					return err
+				}
+			}
+			dst.Set(s)
+		}
+	case t.Kind() == reflect.Map && t.Key().Kind() == reflect.String:
+		var obj map[string]any
+		if obj, ok = bindObject(v); ok {
+			path := bindPath(prefix, key)
+			m := reflect.MakeMapWithSize(t, len(obj))
+			for k, e := range obj {
+				ev := reflect.New(t.Elem()).Elem()
+				if err := bindValue(ev, e, path, k); err != nil {
+					return err
+				}
+				m.SetMapIndex(reflect.ValueOf(k).Convert(t.Key()), ev)
+			}
+			dst.Set(m)
+		}
+	default:
+		return fmt.Errorf("cannot bind meow `%s` to a field of type %s", bindPath(prefix, key), t)
+	}
+	if !ok {
+		return bindError(bindPath(prefix, key), t.String())
+	}
+	return nil
+}
+
+// Binding gives the decoders generated by cmd/meowbind the building blocks of Meow.Bind, so
+// that they bind exactly like it. It is not meant to be used by other code.
+type Binding struct{}
+
+// Lookup walks a sequence of keys down an object of the meow.
+func (Binding) Lookup(obj map[string]any, key ...string) (any, bool) { return bindLookup(obj, key...) }
+
+// Path joins the keys of a nested value for error messages.
+func (Binding) Path(prefix string, key string) string { return bindPath(prefix, key) }
+
+// Error reports a value at path that cannot be bound to a field of type typ.
+func (Binding) Error(path string, typ string) error { return bindError(path, typ) }
+
+// String converts a value to a string.
+func (Binding) String(v any) (string, bool) { return bindString(v) }
+
+// Bool converts a value to a bool.
+func (Binding) Bool(v any) (bool, bool) { return bindBool(v) }
+
+// Int converts a value to a signed integer of the given bit size, 0 for int.
+func (Binding) Int(v any, bits int) (int64, bool) { return bindInt(v, bits) }
+
+// Uint converts a value to an unsigned integer of the given bit size, 0 for uint.
+func (Binding) Uint(v any, bits int) (uint64, bool) { return bindUint(v, bits) }
+
+// Float converts a value to a float of the given bit size.
+func (Binding) Float(v any, bits int) (float64, bool) { return bindFloat(v, bits) }
+
+// Duration converts a string value to a time.Duration.
+func (Binding) Duration(v any) (time.Duration, bool) { return bindDuration(v) }
+
+// Object converts a value to an object.
+func (Binding) Object(v any) (map[string]any, bool) { return bindObject(v) }
+
+// Array converts a value to an array.
+func (Binding) Array(v any) ([]any, bool) { return bindArray(v) }
+
+// bindLookup walks a sequence of keys down an object of the meow.
+func bindLookup(obj map[string]any, key ...string) (any, bool) {
+	last := len(key) - 1
+	for i := 0; i < last; i++ {
+		var ok bool
+		obj, ok = obj[key[i]].(map[string]any)
+		if !ok {
+			return nil, false
+		}
+	}
+	v, ok := obj[key[last]]
+	return v, ok
+}
+
+// bindPath joins the keys of a nested value for error messages.
+func bindPath(prefix string, key string) string {
+	switch {
+	case prefix == "":
+		return key
+	case key == "[]":
+		return prefix + key
+	}
+	return prefix + "." + key
+}
+
+// bindError reports a value at path that cannot be bound to a field of type typ.
+func bindError(path string, typ string) error {
+	return fmt.Errorf("meow `%s` is not a valid %s", path, typ)
+}
+
+// bindString converts a value to a string.
+func bindString(v any) (string, bool) {
+	s, ok := v.(string)
+	return s, ok
+}
+
+// bindBool converts a value to a bool.
+func bindBool(v any) (bool, bool) {
+	b, ok := v.(bool)
+	return b, ok
+}
+
+// bindInt converts a value to a signed integer of the given bit size, 0 for int.
+func bindInt(v any, bits int) (int64, bool) {
+	if bits == 0 {
+		bits = strconv.IntSize
+	}
+	if n, ok := v.(json.Number); ok {
+		if i, err := strconv.ParseInt(string(n), 10, bits); err == nil {
+			return i, true
+		}
+	}
+	a, ok := bindFloat(v, 64)
+	limit := math.Ldexp(1, bits-1)
+	if !ok || a != math.Trunc(a) || a < -limit || a >= limit {
+		return 0, false
+	}
+	return int64(a), true
+}
+
+// bindUint converts a value to an unsigned integer of the given bit size, 0 for uint.
+func bindUint(v any, bits int) (uint64, bool) {
+	if bits == 0 {
+		bits = strconv.IntSize
+	}
+	if n, ok := v.(json.Number); ok {
+		if u, err := strconv.ParseUint(string(n), 10, bits); err == nil {
+			return u, true
+		}
+	}
+	a, ok := bindFloat(v, 64)
+	if !ok || a != math.Trunc(a) || a < 0 || a >= math.Ldexp(1, bits) {
+		return 0, false
+	}
+	return uint64(a), true
+}
+
+// bindFloat converts a value to a float of the given bit size.
+func bindFloat(v any, bits int) (float64, bool) {
+	a, ok := numberOf(v)
+	if !ok || bits == 32 && math.Abs(a) > math.MaxFloat32 {
+		return 0, false
+	}
+	return a, true
+}
+
+// bindDuration converts a string value to a time.Duration.
+func bindDuration(v any) (time.Duration, bool) {
+	s, ok := v.(string)
+	if !ok {
+		return 0, false
+	}
+	d, err := time.ParseDuration(s)
+	return d, err == nil
+}
+
+// bindObject converts a value to an object.
+func bindObject(v any) (map[string]any, bool) {
+	obj, ok := v.(map[string]any)
+	return obj, ok
+}
+
+// bindArray converts a value to an array.
+func bindArray(v any) ([]any, bool) {
+	a, ok := v.([]any)
+	return a, ok
+}
@@ -0,0 +1,198 @@
+// Code generated by meowbind; DO NOT EDIT.
+
+package meow_test
+
+import (
+	meow "github.com/x64x2/mw"
+)
+
+// BindMeow binds c from the meow, see meow.Bind.
+func (c *genConfig) BindMeow(m *meow.Meow) error {
+	obj, _ := m.Value().(map[string]any)
+	return meowBindgenConfig(meow.Binding{}, obj, "", c)
+}
+
+func meowBindgenConfig(b meow.Binding, obj map[string]any, prefix string, c *genConfig) error {
+	if v, ok := b.Lookup(obj, "string"); ok {
+		if v != nil {
+			if x, ok := b.String(v); ok {
+				c.Name = x
+			} else {
+				return b.Error(b.Path(prefix, "string"), "string")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "int"); ok {
+		if v != nil {
+			if x, ok := b.Int(v, 8); ok {
+				c.Count = int8(x)
+			} else {
+				return b.Error(b.Path(prefix, "int"), "int8")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "db", "pool", "max"); ok {
+		if v != nil {
+			if x, ok := b.Uint(v, 0); ok {
+				c.Max = uint(x)
+			} else {
+				return b.Error(b.Path(prefix, "db.pool.max"), "uint")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "db", "ratio"); ok {
+		if v != nil {
+			if x, ok := b.Float(v, 32); ok {
+				c.Ratio = float32(x)
+			} else {
+				return b.Error(b.Path(prefix, "db.ratio"), "float32")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "db", "on"); ok {
+		if v != nil {
+			if x, ok := b.Bool(v); ok {
+				c.On = x
+			} else {
+				return b.Error(b.Path(prefix, "db.on"), "bool")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "db", "timeout"); ok {
+		if v != nil {
+			if x, ok := b.Duration(v); ok {
+				c.Timeout = x
+			} else {
+				return b.Error(b.Path(prefix, "db.timeout"), "time.Duration")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "slice-string"); ok {
+		if v != nil {
+			if a, ok := b.Array(v); ok {
+				s0 := make([]string, len(a))
+				for i0, e0 := range a {
+					if e0 != nil {
+						if x, ok := b.String(e0); ok {
+							s0[i0] = x
+						} else {
+							return b.Error(b.Path(b.Path(prefix, "slice-string"), "[]"), "string")
+						}
+					}
+				}
+				c.Tags = s0
+			} else {
+				return b.Error(b.Path(prefix, "slice-string"), "[]string")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "Ints"); ok {
+		if v != nil {
+			if o, ok := b.Object(v); ok {
+				m0 := make(map[string]int, len(o))
+				for k0, e0 := range o {
+					var x0 int
+					if e0 != nil {
+						if x, ok := b.Int(e0, 0); ok {
+							x0 = int(x)
+						} else {
+							return b.Error(b.Path(b.Path(prefix, "Ints"), k0), "int")
+						}
+					}
+					m0[k0] = x0
+				}
+				c.Ints = m0
+			} else {
+				return b.Error(b.Path(prefix, "Ints"), "map[string]int")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "groups"); ok {
+		if v != nil {
+			if o, ok := b.Object(v); ok {
+				m0 := make(map[string][]genPool, len(o))
+				for k0, e0 := range o {
+					var x0 []genPool
+					if e0 != nil {
+						if a, ok := b.Array(e0); ok {
+							s1 := make([]genPool, len(a))
+							for i1, e1 := range a {
+								if e1 != nil {
+									if o, ok := b.Object(e1); ok {
+										if err := meowBindgenPool(b, o, b.Path(b.Path(b.Path(prefix, "groups"), k0), "[]"), &s1[i1]); err != nil {
+											return err
+										}
+									} else {
+										return b.Error(b.Path(b.Path(b.Path(prefix, "groups"), k0), "[]"), "meow_test.genPool")
+									}
+								}
+							}
+							x0 = s1
+						} else {
+							return b.Error(b.Path(b.Path(prefix, "groups"), k0), "[]meow_test.genPool")
+						}
+					}
+					m0[k0] = x0
+				}
+				c.Groups = m0
+			} else {
+				return b.Error(b.Path(prefix, "groups"), "map[string][]meow_test.genPool")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "g1"); ok {
+		if v != nil {
+			c.Raw = v
+		}
+	}
+	if v, ok := b.Lookup(obj, "db", "pool"); ok {
+		if v != nil {
+			if o, ok := b.Object(v); ok {
+				if err := meowBindgenPool(b, o, b.Path(prefix, "db.pool"), &c.Pool); err != nil {
+					return err
+				}
+			} else {
+				return b.Error(b.Path(prefix, "db.pool"), "meow_test.genPool")
+			}
+		}
+	}
+	if err := meowBindgenEmbedded(b, obj, prefix, &c.genEmbedded); err != nil {
+		return err
+	}
+	return nil
+}
+
+func meowBindgenPool(b meow.Binding, obj map[string]any, prefix string, c *genPool) error {
+	if v, ok := b.Lookup(obj, "max"); ok {
+		if v != nil {
+			if x, ok := b.Int(v, 0); ok {
+				c.Max = int(x)
+			} else {
+				return b.Error(b.Path(prefix, "max"), "int")
+			}
+		}
+	}
+	if v, ok := b.Lookup(obj, "name"); ok {
+		if v != nil {
+			if x, ok := b.String(v); ok {
+				c.Name = x
+			} else {
+				return b.Error(b.Path(prefix, "name"), "string")
+			}
+		}
+	}
+	return nil
+}
+
+func meowBindgenEmbedded(b meow.Binding, obj map[string]any, prefix string, c *genEmbedded) error {
+	if v, ok := b.Lookup(obj, "int"); ok {
+		if v != nil {
+			if x, ok := b.Int(v, 0); ok {
+				c.Int = int(x)
+			} else {
+				return b.Error(b.Path(prefix, "int"), "int")
+			}
+		}
+	}
+	return nil
+}
@@ -0,0 +1,112 @@
+package meow_test
+
+import (
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+
+	meow "github.com/x64x2/mw"
+)
+
+//go:generate go run ./cmd/meowbind -type genConfig bindgen_test.go
+
+type genConfig struct {
+	Name    string        `meow:"string"`
+	Count   int8          `meow:"int"`
+	Max     uint          `meow:"db.pool.max"`
+	Ratio   float32       `meow:"db.ratio"`
+	On      bool          `meow:"db.on"`
+	Timeout time.Duration `meow:"db.timeout"`
+	Tags    []string      `meow:"slice-string"`
+	Ints    map[string]int
+	Groups  map[string][]genPool `meow:"groups"`
+	Raw     any                  `meow:"g1"`
+	Pool    genPool              `meow:"db.pool"`
+	genEmbedded
+	Skipped string `meow:"-"`
+	skipped string
+}
+
+type genPool struct {
+	Max  int    `meow:"max"`
+	Name string `meow:"name"`
+}
+
+type genEmbedded struct {
+	Int int `meow:"int"`
+}
+
+type reflectConfig genConfig
+
+const genBody = `{"chess": {
+	"string": "S", "int": 1, "slice-string": ["a", null, "b"], "g1": {"a1": "A"},
+	"Ints": {"a": 1, "b": 2},
+	"db": {"pool": {"max": 10, "name": "main"}, "ratio": 0.5, "on": true, "timeout": "1m30s"},
+	"groups": {"x": [{"max": 1}, {"name": "n"}]}
+}}`
+
+func TestBindGenerated(t *testing.T) {
+
+	m, err := meow.LoadReader("chess", strings.NewReader(genBody))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	var generated genConfig
+	var reflected reflectConfig
+	if err := m.Bind(&generated); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if err := m.Bind(&reflected); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if !reflect.DeepEqual(genConfig(reflected), generated) {
+		t.Errorf("Error: found\n%+v\nexpected\n%+v", generated, reflected)
+	}
+	if generated.Timeout != 90*time.Second || generated.Pool.Name != "main" || generated.Int != 1 || generated.Groups["x"][1].Name != "n" {
+		t.Errorf("Error: found %+v", generated)
+	}
+
+	if err := m.Bind(reflected); err == nil {
+		t.Errorf("Error: bound to a struct value")
+	}
+
+	for _, doc := range []string{
+		`{"chess": {"int": 300}}`,
+		`{"chess": {"db": {"pool": {"max": -1}}}}`,
+		`{"chess": {"db": {"timeout": 10}}}`,
+		`{"chess": {"groups": {"x": [{"max": "1"}]}}}`,
+		`{"chess": {"Ints": {"a": 1.5}}}`,
+		`{"chess": {"db": {"pool": []}}}`,
+	} {
+		m, err := meow.LoadReader("chess", strings.NewReader(doc))
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		err1, err2 := m.Bind(&genConfig{}), m.Bind(&reflectConfig{})
+		if err1 == nil || err2 == nil || err1.Error() != err2.Error() {
+			t.Errorf("Error: found `%v` and `%v` for %s", err1, err2, doc)
+		}
+	}
+}
+
+func BenchmarkBind(b *testing.B) {
+	m, err := meow.LoadReader("chess", strings.NewReader(genBody))
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Run("generated", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			var c genConfig
+			_ = m.Bind(&c)
+		}
+	})
+	b.Run("reflect", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			var c reflectConfig
+			_ = m.Bind(&c)
+		}
+	})
+}
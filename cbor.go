@@ -0,0 +1,359 @@
+package meow
+
+import (
+	"fmt"
+	"math"
+)
+
+// CBOR decodes meow documents encoded with CBOR (RFC 8949), see WithDecoder. Documents
+// starting with a CBOR map are detected and decoded with it without WithDecoder. Maps must
+// have text keys; byte strings decode to strings, integers and floats to float64 or
+// json.Number, undefined to nil. Tags are skipped, except bignums which are rejected.
+type CBOR struct{}
+
+// Valid reports whether data is a single valid CBOR data item. It does not allocate for
+// strings of definite length.
+func (CBOR) Valid(data []byte) bool {
+	r := cborReader{data: data}
+	return r.skip(0) == nil && r.i == len(data)
+}
+
+// Decode decodes data, a single CBOR data item.
+func (CBOR) Decode(data []byte, numbers bool) (any, error) {
+	r := cborReader{data: data, numbers: numbers}
+	v, err := r.value(0)
+	if err == nil && r.i != len(data) {
+		err = fmt.Errorf("invalid CBOR: trailing data")
+	}
+	return v, err
+}
+
+func (CBOR) split(data []byte) ([]span, error) {
+	r := cborReader{data: data}
+	r.skipTags()
+	major, n, err := r.head()
+	if err != nil {
+		return nil, err
+	}
+	if major != cborMap {
+		return nil, fmt.Errorf("does not contain a valid CBOR map")
+	}
+	var spans []span
+	for i := uint64(0); n == cborIndefinite || i < n; i++ {
+		if n == cborIndefinite && r.atBreak() {
+			break
+		}
+		key, err := r.key()
+		if err != nil {
+			return nil, err
+		}
+		start := r.i
+		if err := r.skip(1); err != nil {
+			return nil, err
+		}
+		spans = append(spans, span{key, start, r.i})
+	}
+	if r.i != len(data) {
+		return nil, fmt.Errorf("invalid CBOR: trailing data")
+	}
+	return spans, nil
+}
+
+func (CBOR) object(c byte) bool {
+	return c>>5 == cborMap
+}
+
+// The major types of CBOR.
+const (
+	cborUnsigned = iota
+	cborNegative
+	cborBytes
+	cborText
+	cborArray
+	cborMap
+	cborTag
+	cborSimple
+)
+
+// cborIndefinite is the argument head returns for an indefinite length.
+const cborIndefinite = math.MaxUint64
+
+// cborReader reads CBOR data items from data at offset i.
+type cborReader struct {
+	data    []byte
+	i       int
+	numbers bool
+	// info is the additional information of the last head, which tells the size of floats.
+	info byte
+}
+
+func (r *cborReader) errorf(format string, args ...any) error {
+	return fmt.Errorf("invalid CBOR at offset %d: %s", r.i, fmt.Sprintf(format, args...))
+}
+
+// next returns the n bytes at the offset and moves past them.
+func (r *cborReader) next(n uint64) ([]byte, error) {
+	if n > uint64(len(r.data)-r.i) {
+		return nil, r.errorf("unexpected end")
+	}
+	b := r.data[r.i : r.i+int(n)]
+	r.i += int(n)
+	return b, nil
+}
+
+// head reads the initial byte of a data item and its argument: the value of an integer, the
+// length of a string, an array or a map, the number of a tag, or the bits of a float.
+// Indefinite lengths return cborIndefinite.
+func (r *cborReader) head() (byte, uint64, error) {
+	if r.i == len(r.data) {
+		return 0, 0, r.errorf("unexpected end")
+	}
+	c := r.data[r.i]
+	r.i++
+	major, info := c>>5, c&0x1f
+	r.info = info
+	switch {
+	case info < 24:
+		return major, uint64(info), nil
+	case info <= 27:
+		b, err := r.next(1 << (info - 24))
+		if err != nil {
+			return 0, 0, err
+		}
+		var u uint64
+		for _, x := range b {
+			u = u<<8 | uint64(x)
+		}
+		return major, u, nil
+	case info == 31 && major >= cborBytes && major <= cborMap:
+		return major, cborIndefinite, nil
+	}
+	r.i--
+	return 0, 0, r.errorf("invalid initial byte 0x%02x", c)
+}
+
+// atBreak reports whether the offset is at the break ending an indefinite length, and moves
+// past it.
+func (r *cborReader) atBreak() bool {
+	if r.i < len(r.data) && r.data[r.i] == 0xff {
+		r.i++
+		return true
+	}
+	return false
+}
+
+func (r *cborReader) skipTags() {
+	for r.i < len(r.data) && r.data[r.i]>>5 == cborTag {
+		if _, _, err := r.head(); err != nil {
+			return
+		}
+	}
+}
+
+// text reads the content of a string of the given major type and length. Strings of
+// indefinite length are concatenated from their chunks.
+func (r *cborReader) text(major byte, n uint64) ([]byte, error) {
+	if n != cborIndefinite {
+		return r.next(n)
+	}
+	var b []byte
+	for !r.atBreak() {
+		m, n, err := r.head()
+		if err != nil {
+			return nil, err
+		}
+		if m != major || n == cborIndefinite {
+			return nil, r.errorf("invalid chunk of an indefinite string")
+		}
+		chunk, err := r.next(n)
+		if err != nil {
+			return nil, err
+		}
+		b = append(b, chunk...)
+	}
+	return b, nil
+}
+
+func (r *cborReader) key() (string, error) {
+	b, err := r.keyBytes()
+	return string(b), err
+}
+
+func (r *cborReader) keyBytes() ([]byte, error) {
+	major, n, err := r.head()
+	if err != nil {
+		return nil, err
+	}
+	if major != cborText {
+		return nil, r.errorf("map key is not a text string")
+	}
+	return r.text(major, n)
+}
+
+// skip moves past a data item without decoding it.
+func (r *cborReader) skip(depth int) error {
+	if depth > maxDepth {
+		return r.errorf("exceeded max depth")
+	}
+	major, n, err := r.head()
+	if err != nil {
+		return err
+	}
+	switch major {
+	case cborBytes, cborText:
+		_, err = r.text(major, n)
+		return err
+	case cborArray, cborMap:
+		for i := uint64(0); n == cborIndefinite || i < n; i++ {
+			if n == cborIndefinite && r.atBreak() {
+				break
+			}
+			if major == cborMap {
+				if _, err := r.keyBytes(); err != nil {
+					return err
+				}
+			}
+			if err := r.skip(depth + 1); err != nil {
+				return err
+			}
+		}
+		return nil
+	case cborTag:
+		if n == 2 || n == 3 {
+			return r.errorf("unsupported bignum")
+		}
+		return r.skip(depth + 1)
+	case cborSimple:
+		if r.info < 20 || r.info > 23 {
+			_, err = r.float(n)
+		}
+		return err
+	}
+	return nil
+}
+
+func (r *cborReader) value(depth int) (any, error) {
+	if depth > maxDepth {
+		return nil, r.errorf("exceeded max depth")
+	}
+	major, n, err := r.head()
+	if err != nil {
+		return nil, err
+	}
+	switch major {
+	case cborUnsigned:
+		return unsigned(n, r.numbers), nil
+	case cborNegative:
+		return negative(n, r.numbers), nil
+	case cborBytes, cborText:
+		b, err := r.text(major, n)
+		return string(b), err
+	case cborArray:
+		var a []any
+		if n != cborIndefinite {
+			if n > uint64(len(r.data)-r.i) {
+				return nil, r.errorf("unexpected end")
+			}
+			a = make([]any, 0, n)
+		}
+		for i := uint64(0); n == cborIndefinite || i < n; i++ {
+			if n == cborIndefinite && r.atBreak() {
+				break
+			}
+			v, err := r.value(depth + 1)
+			if err != nil {
+				return nil, err
+			}
+			a = append(a, v)
+		}
+		if a == nil {
+			a = []any{}
+		}
+		return a, nil
+	case cborMap:
+		size := 0
+		if n != cborIndefinite {
+			if n > uint64(len(r.data)-r.i)/2 {
+				return nil, r.errorf("unexpected end")
+			}
+			size = int(n)
+		}
+		m := make(map[string]any, size)
+		for i := uint64(0); n == cborIndefinite || i < n; i++ {
+			if n == cborIndefinite && r.atBreak() {
+				break
+			}
+			k, err := r.key()
+			if err != nil {
+				return nil, err
+			}
+			if m[k], err = r.value(depth + 1); err != nil {
+				return nil, err
+			}
+		}
+		return m, nil
+	case cborTag:
+		if n == 2 || n == 3 {
+			return nil, r.errorf("unsupported bignum")
+		}
+		return r.value(depth + 1)
+	}
+	return r.simple(n)
+}
+
+// simple decodes a data item of major type 7 with argument n.
+func (r *cborReader) simple(n uint64) (any, error) {
+	switch r.info {
+	case 20, 21:
+		return r.info == 21, nil
+	case 22, 23:
+		return nil, nil
+	}
+	f, err := r.float(n)
+	if err != nil {
+		return nil, err
+	}
+	return float(f, r.numbers), nil
+}
+
+// float converts the bits n of a float of major type 7 and rejects values that are not
+// finite.
+func (r *cborReader) float(n uint64) (float64, error) {
+	var f float64
+	switch r.info {
+	case 25:
+		f = halfFloat(uint16(n))
+	case 26:
+		f = float64(math.Float32frombits(uint32(n)))
+	case 27:
+		f = math.Float64frombits(n)
+	default:
+		return 0, r.errorf("unsupported simple value %d", n)
+	}
+	if math.IsNaN(f) || math.IsInf(f, 0) {
+		return 0, r.errorf("number is not finite")
+	}
+	return f, nil
+}
+
+// halfFloat converts an IEEE 754 half-precision float.
+func halfFloat(h uint16) float64 {
+	exp := int(h>>10) & 0x1f
+	mant := float64(h & 0x3ff)
+	var f float64
+	switch exp {
+	case 0:
+		f = math.Ldexp(mant, -24)
+	case 0x1f:
+		f = math.Inf(1)
+		if mant != 0 {
+			f = math.NaN()
+		}
+	default:
+		f = math.Ldexp(mant+1024, exp-25)
+	}
+	if h&0x8000 != 0 {
+		f = -f
+	}
+	return f
+}
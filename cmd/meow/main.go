@@ -0,0 +1,61 @@
+// Command meow works with meow files from the command line.
+//
+//	meow compile -appid chess [-deep] [-numbers] -o meow.snap meow.json
+//
+// compile merges the layers of a meow file for an application and writes the result as a
+// binary snapshot, which meow.LoadSnapshot loads without decoding JSON. The snapshot is only
+// loaded with the options given here: -deep for meow.WithDeepMerge, -numbers for
+// meow.WithNumbers.
+package main
+
+import (
+	"flag"
+	"fmt"
+	"os"
+
+	meow "github.com/x64x2/mw"
+)
+
+func main() {
+	if len(os.Args) < 2 {
+		usage()
+	}
+	switch os.Args[1] {
+	case "compile":
+		compile(os.Args[2:])
+	default:
+		usage()
+	}
+}
+
+func usage() {
+	fmt.Fprintln(os.Stderr, "usage: meow compile -appid appid [-deep] [-numbers] [-o snapshot] meowfile")
+	os.Exit(2)
+}
+
+func compile(args []string) {
+	fs := flag.NewFlagSet("compile", flag.ExitOnError)
+	appid := fs.String("appid", "", "application identification")
+	out := fs.String("o", "", "snapshot file, meowfile with .snap appended by default")
+	deep := fs.Bool("deep", false, "merge nested objects across layers")
+	numbers := fs.Bool("numbers", false, "keep numbers as their JSON text")
+	fs.Parse(args)
+	if *appid == "" || fs.NArg() != 1 {
+		usage()
+	}
+	meowFile := fs.Arg(0)
+	if *out == "" {
+		*out = meowFile + ".snap"
+	}
+	var opts []meow.Option
+	if *deep {
+		opts = append(opts, meow.WithDeepMerge())
+	}
+	if *numbers {
+		opts = append(opts, meow.WithNumbers())
+	}
+	if err := meow.CompileSnapshot(*appid, meowFile, *out, opts...); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+}
@@ -0,0 +1,302 @@
+// Command meowbind generates reflection-free meow decoders for structs. It is meant to be
+// run by go generate:
+//
+//	//go:generate go run github.com/x64x2/mw/cmd/meowbind -type Config
+//
+// For every listed type, meowbind writes a BindMeow method binding the struct exactly like
+// meow.Bind, which then calls it instead of using reflection. The listed types, and the
+// structs they nest, must be declared in the processed file, $GOFILE by default. The output
+// goes to the file name with _meow appended, before _test for test files.
+package main
+
+import (
+	"bytes"
+	"flag"
+	"fmt"
+	"go/ast"
+	"go/format"
+	"go/parser"
+	"go/token"
+	"go/types"
+	"os"
+	"reflect"
+	"sort"
+	"strconv"
+	"strings"
+)
+
+func main() {
+	typeNames := flag.String("type", "", "comma separated list of struct types")
+	output := flag.String("o", "", "output file")
+	flag.Parse()
+	file := os.Getenv("GOFILE")
+	if flag.NArg() > 0 {
+		file = flag.Arg(0)
+	}
+	if *typeNames == "" || file == "" {
+		fmt.Fprintln(os.Stderr, "usage: meowbind -type T[,T...] [-o output] [file.go]")
+		os.Exit(2)
+	}
+	if *output == "" {
+		*output = outputName(file)
+	}
+
+	src, err := os.ReadFile(file)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	code, err := generate(file, src, strings.Split(*typeNames, ","))
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	if err := os.WriteFile(*output, code, 0o644); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+}
+
+func outputName(file string) string {
+	base := strings.TrimSuffix(file, ".go")
+	if strings.HasSuffix(base, "_test") {
+		return strings.TrimSuffix(base, "_test") + "_meow_test.go"
+	}
+	return base + "_meow.go"
+}
+
+type generator struct {
+	pkg     string
+	structs map[string]*ast.StructType
+	imports map[string]string
+	used    map[string]bool
+	queued  map[string]bool
+	queue   []string
+	buf     bytes.Buffer
+}
+
+// generate returns the decoders for the given types declared in src.
+func generate(file string, src []byte, typeNames []string) ([]byte, error) {
+	f, err := parser.ParseFile(token.NewFileSet(), file, src, 0)
+	if err != nil {
+		return nil, err
+	}
+	g := &generator{
+		pkg:     f.Name.Name,
+		structs: make(map[string]*ast.StructType),
+		imports: make(map[string]string),
+		used:    make(map[string]bool),
+		queued:  make(map[string]bool),
+	}
+	for _, imp := range f.Imports {
+		path, _ := strconv.Unquote(imp.Path.Value)
+		name := path[strings.LastIndex(path, "/")+1:]
+		if imp.Name != nil {
+			name = imp.Name.Name
+		}
+		g.imports[name] = path
+	}
+	ast.Inspect(f, func(n ast.Node) bool {
+		if ts, ok := n.(*ast.TypeSpec); ok {
+			if st, ok := ts.Type.(*ast.StructType); ok {
+				g.structs[ts.Name.Name] = st
+			}
+		}
+		return true
+	})
+
+	var body bytes.Buffer
+	for _, name := range typeNames {
+		if g.structs[name] == nil {
+			return nil, fmt.Errorf("%s: no struct type %s", file, name)
+		}
+		fmt.Fprintf(&body, "// BindMeow binds c from the meow, see meow.Bind.\n")
+		fmt.Fprintf(&body, "func (c *%s) BindMeow(m *meow.Meow) error {\n", name)
+		fmt.Fprintf(&body, "obj, _ := m.Value().(map[string]any)\nreturn meowBind%s(meow.Binding{}, obj, \"\", c)\n}\n\n", name)
+		g.enqueue(name)
+	}
+	for len(g.queue) > 0 {
+		name := g.queue[0]
+		g.queue = g.queue[1:]
+		if err := g.bindFunc(name); err != nil {
+			return nil, fmt.Errorf("%s: %s", file, err)
+		}
+	}
+	body.Write(g.buf.Bytes())
+
+	var out bytes.Buffer
+	fmt.Fprintf(&out, "// Code generated by meowbind; DO NOT EDIT.\n\npackage %s\n\nimport (\n", f.Name.Name)
+	fmt.Fprintf(&out, "meow %q\n", "github.com/x64x2/mw")
+	var used []string
+	for name := range g.used {
+		used = append(used, name)
+	}
+	sort.Strings(used)
+	for _, name := range used {
+		fmt.Fprintf(&out, "%s %q\n", name, g.imports[name])
+	}
+	fmt.Fprintf(&out, ")\n\n")
+	out.Write(body.Bytes())
+	return format.Source(out.Bytes())
+}
+
+func (g *generator) enqueue(name string) {
+	if !g.queued[name] {
+		g.queued[name] = true
+		g.queue = append(g.queue, name)
+	}
+}
+
+// bindFunc writes the decoder of a struct, the counterpart of bindStruct in package meow.
+func (g *generator) bindFunc(name string) error {
+	fmt.Fprintf(&g.buf, "func meowBind%s(b meow.Binding, obj map[string]any, prefix string, c *%s) error {\n", name, name)
+	for _, field := range g.structs[name].Fields.List {
+		tag, tagged := "", false
+		if field.Tag != nil {
+			s, _ := strconv.Unquote(field.Tag.Value)
+			tag, tagged = reflect.StructTag(s).Lookup("meow")
+		}
+		if tag == "-" {
+			continue
+		}
+		names := field.Names
+		if len(names) == 0 {
+			id, ok := field.Type.(*ast.Ident)
+			if !ok {
+				return fmt.Errorf("%s: unsupported embedded field %s", name, types.ExprString(field.Type))
+			}
+			if !tagged && g.structs[id.Name] != nil {
+				g.enqueue(id.Name)
+				fmt.Fprintf(&g.buf, "if err := meowBind%s(b, obj, prefix, &c.%s); err != nil {\nreturn err\n}\n", id.Name, id.Name)
+				continue
+			}
+			names = []*ast.Ident{id}
+		}
+		for _, id := range names {
+			if !ast.IsExported(id.Name) {
+				continue
+			}
+			key := tag
+			if key == "" {
+				key = id.Name
+			}
+			var quoted []string
+			for _, k := range strings.Split(key, ".") {
+				quoted = append(quoted, strconv.Quote(k))
+			}
+			fmt.Fprintf(&g.buf, "if v, ok := b.Lookup(obj, %s); ok {\n", strings.Join(quoted, ", "))
+			path := fmt.Sprintf("b.Path(prefix, %q)", key)
+			if err := g.assign("c."+id.Name, field.Type, "v", path, 0); err != nil {
+				return fmt.Errorf("%s.%s: %s", name, id.Name, err)
+			}
+			fmt.Fprintf(&g.buf, "}\n")
+		}
+	}
+	fmt.Fprintf(&g.buf, "return nil\n}\n\n")
+	return nil
+}
+
+var intBits = map[string]int{"int": 0, "int8": 8, "int16": 16, "int32": 32, "int64": 64}
+var uintBits = map[string]int{"uint": 0, "uint8": 8, "byte": 8, "uint16": 16, "uint32": 32, "uint64": 64}
+
+// assign writes the conversion of src into dst, the counterpart of bindValue in package meow.
+// path is the expression of the keys of src, only evaluated for errors.
+func (g *generator) assign(dst string, typ ast.Expr, src string, path string, depth int) error {
+	w := &g.buf
+	typeName := g.reflectString(typ)
+	fail := fmt.Sprintf("} else {\nreturn b.Error(%s, %q)\n}\n", path, typeName)
+	fmt.Fprintf(w, "if %s != nil {\n", src)
+	defer fmt.Fprintf(w, "}\n")
+
+	switch t := typ.(type) {
+	case *ast.Ident:
+		switch {
+		case t.Name == "string":
+			fmt.Fprintf(w, "if x, ok := b.String(%s); ok {\n%s = x\n%s", src, dst, fail)
+		case t.Name == "bool":
+			fmt.Fprintf(w, "if x, ok := b.Bool(%s); ok {\n%s = x\n%s", src, dst, fail)
+		case t.Name == "float32" || t.Name == "float64":
+			fmt.Fprintf(w, "if x, ok := b.Float(%s, %s); ok {\n%s = %s(x)\n%s", src, t.Name[5:], dst, t.Name, fail)
+		case t.Name == "any":
+			fmt.Fprintf(w, "%s = %s\n", dst, src)
+		case g.structs[t.Name] != nil:
+			g.enqueue(t.Name)
+			fmt.Fprintf(w, "if o, ok := b.Object(%s); ok {\nif err := meowBind%s(b, o, %s, &%s); err != nil {\nreturn err\n}\n%s", src, t.Name, path, dst, fail)
+		default:
+			if bits, ok := intBits[t.Name]; ok {
+				fmt.Fprintf(w, "if x, ok := b.Int(%s, %d); ok {\n%s = %s(x)\n%s", src, bits, dst, t.Name, fail)
+			} else if bits, ok := uintBits[t.Name]; ok {
+				fmt.Fprintf(w, "if x, ok := b.Uint(%s, %d); ok {\n%s = %s(x)\n%s", src, bits, dst, t.Name, fail)
+			} else {
+				return fmt.Errorf("unsupported type %s", t.Name)
+			}
+		}
+	case *ast.SelectorExpr:
+		if pkg, ok := t.X.(*ast.Ident); !ok || g.imports[pkg.Name] != "time" || t.Sel.Name != "Duration" {
+			return fmt.Errorf("unsupported type %s", typeName)
+		}
+		fmt.Fprintf(w, "if x, ok := b.Duration(%s); ok {\n%s = x\n%s", src, dst, fail)
+	case *ast.InterfaceType:
+		if len(t.Methods.List) > 0 {
+			return fmt.Errorf("unsupported type %s", typeName)
+		}
+		fmt.Fprintf(w, "%s = %s\n", dst, src)
+	case *ast.ArrayType:
+		if t.Len != nil {
+			return fmt.Errorf("unsupported type %s", typeName)
+		}
+		s, i, e := fmt.Sprintf("s%d", depth), fmt.Sprintf("i%d", depth), fmt.Sprintf("e%d", depth)
+		fmt.Fprintf(w, "if a, ok := b.Array(%s); ok {\n%s := make(%s, len(a))\nfor %s, %s := range a {\n", src, s, g.typeString(t), i, e)
+		if err := g.assign(s+"["+i+"]", t.Elt, e, fmt.Sprintf("b.Path(%s, %q)", path, "[]"), depth+1); err != nil {
+			return err
+		}
+		fmt.Fprintf(w, "}\n%s = %s\n%s", dst, s, fail)
+	case *ast.MapType:
+		if id, ok := t.Key.(*ast.Ident); !ok || id.Name != "string" {
+			return fmt.Errorf("unsupported type %s", typeName)
+		}
+		m, k, e, x := fmt.Sprintf("m%d", depth), fmt.Sprintf("k%d", depth), fmt.Sprintf("e%d", depth), fmt.Sprintf("x%d", depth)
+		fmt.Fprintf(w, "if o, ok := b.Object(%s); ok {\n%s := make(%s, len(o))\nfor %s, %s := range o {\nvar %s %s\n", src, m, g.typeString(t), k, e, x, g.typeString(t.Value))
+		if err := g.assign(x, t.Value, e, fmt.Sprintf("b.Path(%s, %s)", path, k), depth+1); err != nil {
+			return err
+		}
+		fmt.Fprintf(w, "%s[%s] = %s\n}\n%s = %s\n%s", m, k, x, dst, m, fail)
+	default:
+		return fmt.Errorf("unsupported type %s", typeName)
+	}
+	return nil
+}
+
+// typeString prints a type expression and records the imports it needs.
+func (g *generator) typeString(typ ast.Expr) string {
+	ast.Inspect(typ, func(n ast.Node) bool {
+		if sel, ok := n.(*ast.SelectorExpr); ok {
+			if pkg, ok := sel.X.(*ast.Ident); ok && g.imports[pkg.Name] != "" {
+				g.used[pkg.Name] = true
+			}
+		}
+		return true
+	})
+	return types.ExprString(typ)
+}
+
+// reflectString prints a type expression the way reflect.Type.String does, for errors
+// identical to the ones of meow.Bind.
+func (g *generator) reflectString(typ ast.Expr) string {
+	switch t := typ.(type) {
+	case *ast.Ident:
+		if t.Name == "any" {
+			return "interface {}"
+		}
+		if g.structs[t.Name] != nil {
+			return g.pkg + "." + t.Name
+		}
+	case *ast.InterfaceType:
+		return "interface {}"
+	case *ast.ArrayType:
+		return "[]" + g.reflectString(t.Elt)
+	case *ast.MapType:
+		return "map[" + g.reflectString(t.Key) + "]" + g.reflectString(t.Value)
+	}
+	return types.ExprString(typ)
+}
@@ -0,0 +1,88 @@
+package meow
+
+// Key is a sequence of keys resolved once against a meow. The walk down the meow and the
+// scalar conversions happen in Compile, so reading through a Key is a field load.
+//
+// A Key is bound to the meow it was compiled against and never changes afterwards. Once a
+// new meow is loaded, Rebind the Key to it; readers holding the old Key keep a consistent
+// view of the old meow in the meantime.
+type Key struct {
+	meow  *Meow
+	path  []string
+	value any
+	found bool
+	str   string
+	num   int
+}
+
+// Compile resolves a sequence of keys against the meow.
+func (meow *Meow) Compile(key ...string) *Key {
+	k := &Key{path: append([]string(nil), key...)}
+	k.resolve(meow)
+	return k
+}
+
+// Rebind resolves the keys of k against another meow, typically the result of a reload.
+func (k *Key) Rebind(meow *Meow) *Key {
+	n := &Key{path: k.path}
+	n.resolve(meow)
+	return n
+}
+
+func (k *Key) resolve(meow *Meow) {
+	k.meow = meow
+	k.value = meow.Value(k.path...)
+	k.found = meow.Exists(k.path...)
+	k.str = asString(k.value)
+	k.num = asInt(k.value)
+}
+
+// Meow returns the meow the key has been resolved against.
+func (k *Key) Meow() *Meow {
+	return k.meow
+}
+
+// Path returns the sequence of keys. The result must not be modified.
+func (k *Key) Path() []string {
+	return k.path
+}
+
+// Value returns the resolved value, see Meow.Value.
+func (k *Key) Value() any {
+	return k.value
+}
+
+// Exists reports whether the key is defined, see Meow.Exists.
+func (k *Key) Exists() bool {
+	return k.found
+}
+
+// ValueString returns the resolved value as a string, see Meow.ValueString.
+func (k *Key) ValueString() string {
+	return k.str
+}
+
+// ValueInt returns the resolved value as an int, see Meow.ValueInt.
+func (k *Key) ValueInt() int {
+	return k.num
+}
+
+// ValueStringMap returns the resolved value as a map[string]string, see Meow.ValueStringMap.
+func (k *Key) ValueStringMap() map[string]string {
+	return k.meow.ValueStringMap(k.path...)
+}
+
+// ValueStringSlice returns the resolved value as a []string, see Meow.ValueStringSlice.
+func (k *Key) ValueStringSlice() []string {
+	return k.meow.ValueStringSlice(k.path...)
+}
+
+// ValueIntMap returns the resolved value as a map[string]int, see Meow.ValueIntMap.
+func (k *Key) ValueIntMap() map[string]int {
+	return k.meow.ValueIntMap(k.path...)
+}
+
+// ValueIntSlice returns the resolved value as a []int, see Meow.ValueIntSlice.
+func (k *Key) ValueIntSlice() []int {
+	return k.meow.ValueIntSlice(k.path...)
+}
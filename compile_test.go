@@ -0,0 +1,48 @@
+package meow
+
+import (
+	"strings"
+	"testing"
+)
+
+func TestCompile(t *testing.T) {
+
+	meow, err := LoadReader("chess", strings.NewReader(body))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+
+	k := meow.Compile("g1", "a1")
+	if !k.Exists() || k.ValueString() != "A" {
+		t.Errorf("Error: found `%s`\n\n%v", k.ValueString(), meow.meow)
+	}
+	if !meow.Exists("g1", "a1") {
+		t.Errorf("Error: `g1.a1` does not exist\n\n%v", meow.meow)
+	}
+	if meow.Compile("g1", "none").Exists() || meow.Compile("string", "none").Exists() {
+		t.Errorf("Error: undefined key exists\n\n%v", meow.meow)
+	}
+	if meow.Compile("int").ValueInt() != 1 {
+		t.Errorf("Error: found `%d`\n\n%v", meow.Compile("int").ValueInt(), meow.meow)
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		_ = k.ValueString()
+		_ = k.Value()
+	})
+	if allocs != 0 {
+		t.Errorf("Error: %v allocations per read", allocs)
+	}
+
+	other, err := LoadReader("chess", strings.NewReader(`{"chess": {"g1": {"a1": "B"}}}`))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	n := k.Rebind(other)
+	if n.ValueString() != "B" || n.Meow() != other {
+		t.Errorf("Error: found `%s` after rebind", n.ValueString())
+	}
+	if k.ValueString() != "A" || k.Meow() != meow {
+		t.Errorf("Error: rebind modified the original key")
+	}
+}
@@ -0,0 +1,416 @@
+package meow
+
+import (
+	"encoding/binary"
+	"encoding/json"
+	"fmt"
+	"math"
+	"math/bits"
+	"strconv"
+	"unicode/utf8"
+)
+
+// Decoder decodes the JSON values of a meow document, see WithDecoder. Decode returns the
+// same values as encoding/json would decode into an any: map[string]any, []any, string,
+// float64, or json.Number when numbers is set, bool and nil. A Decoder is used by several
+// goroutines at once.
+type Decoder interface {
+	// Valid reports whether data is a single valid JSON value.
+	Valid(data []byte) bool
+	// Decode decodes data, a single JSON value.
+	Decode(data []byte, numbers bool) (any, error)
+}
+
+// StdDecoder decodes with encoding/json. It is the decoder used without WithDecoder.
+type StdDecoder struct{}
+
+// Valid reports whether data is a single valid JSON value.
+func (StdDecoder) Valid(data []byte) bool {
+	return json.Valid(data)
+}
+
+// Decode decodes data, a single JSON value.
+func (StdDecoder) Decode(data []byte, numbers bool) (any, error) {
+	var v any
+	err := unmarshal(data, &v, numbers)
+	return v, err
+}
+
+// FastDecoder is a hand-written decoder without reflection. Strings free of escapes are
+// scanned eight bytes at a time and copied once, numbers are parsed in place. It accepts
+// and returns exactly what StdDecoder does.
+type FastDecoder struct{}
+
+// Valid reports whether data is a single valid JSON value. It does not allocate.
+func (FastDecoder) Valid(data []byte) bool {
+	p := parser{data: data, skip: true}
+	return p.document() == nil
+}
+
+// Decode decodes data, a single JSON value.
+func (FastDecoder) Decode(data []byte, numbers bool) (any, error) {
+	p := parser{data: data, numbers: numbers}
+	if err := p.document(); err != nil {
+		return nil, err
+	}
+	return p.v, nil
+}
+
+// maxDepth is the nesting limit of encoding/json.
+const maxDepth = 10000
+
+type parser struct {
+	data    []byte
+	i       int
+	numbers bool
+	skip    bool
+	v       any
+	// members and elements hold the contents of the objects and arrays being read, so
+	// that each is allocated at its final size.
+	members  []member
+	elements []any
+}
+
+type member struct {
+	key   string
+	value any
+}
+
+func (p *parser) document() error {
+	p.space()
+	v, err := p.value(0)
+	if err != nil {
+		return err
+	}
+	if p.space(); p.i != len(p.data) {
+		return p.fail("after top-level value")
+	}
+	p.v = v
+	return nil
+}
+
+func (p *parser) fail(context string) error {
+	if p.i >= len(p.data) {
+		return fmt.Errorf("unexpected end of JSON input")
+	}
+	return fmt.Errorf("invalid character %q %s at offset %d", p.data[p.i], context, p.i)
+}
+
+func (p *parser) space() {
+	for p.i < len(p.data) {
+		switch p.data[p.i] {
+		case ' ', '\t', '\n', '\r':
+			p.i++
+		default:
+			return
+		}
+	}
+}
+
+func (p *parser) value(depth int) (any, error) {
+	if p.i >= len(p.data) {
+		return nil, p.fail("")
+	}
+	switch c := p.data[p.i]; {
+	case c == '{':
+		return p.object(depth + 1)
+	case c == '[':
+		return p.array(depth + 1)
+	case c == '"':
+		s, err := p.str()
+		return s, err
+	case c == '-' || c >= '0' && c <= '9':
+		return p.number()
+	case c == 't':
+		return true, p.literal("true")
+	case c == 'f':
+		return false, p.literal("false")
+	case c == 'n':
+		return nil, p.literal("null")
+	}
+	return nil, p.fail("looking for beginning of value")
+}
+
+func (p *parser) literal(lit string) error {
+	if len(p.data)-p.i < len(lit) || string(p.data[p.i:p.i+len(lit)]) != lit {
+		for j := 0; j < len(lit) && p.i < len(p.data) && p.data[p.i] == lit[j]; j++ {
+			p.i++
+		}
+		return p.fail("in literal " + lit)
+	}
+	p.i += len(lit)
+	return nil
+}
+
+func (p *parser) object(depth int) (any, error) {
+	if depth > maxDepth {
+		return nil, fmt.Errorf("exceeded max depth")
+	}
+	base := len(p.members)
+	defer func() { p.members = p.members[:base] }()
+	p.i++
+	p.space()
+	if p.i < len(p.data) && p.data[p.i] == '}' {
+		p.i++
+		return p.objectOf(base), nil
+	}
+	for {
+		if p.i >= len(p.data) || p.data[p.i] != '"' {
+			return nil, p.fail("looking for beginning of object key string")
+		}
+		k, err := p.str()
+		if err != nil {
+			return nil, err
+		}
+		p.space()
+		if p.i >= len(p.data) || p.data[p.i] != ':' {
+			return nil, p.fail("after object key")
+		}
+		p.i++
+		p.space()
+		v, err := p.value(depth)
+		if err != nil {
+			return nil, err
+		}
+		if !p.skip {
+			p.members = append(p.members, member{k, v})
+		}
+		p.space()
+		if p.i < len(p.data) && p.data[p.i] == ',' {
+			p.i++
+			p.space()
+			continue
+		}
+		if p.i < len(p.data) && p.data[p.i] == '}' {
+			p.i++
+			return p.objectOf(base), nil
+		}
+		return nil, p.fail("after object key:value pair")
+	}
+}
+
+// objectOf returns the map of the members read since base.
+func (p *parser) objectOf(base int) any {
+	if p.skip {
+		return nil
+	}
+	m := make(map[string]any, len(p.members)-base)
+	for _, mb := range p.members[base:] {
+		m[mb.key] = mb.value
+	}
+	return m
+}
+
+func (p *parser) array(depth int) (any, error) {
+	if depth > maxDepth {
+		return nil, fmt.Errorf("exceeded max depth")
+	}
+	base := len(p.elements)
+	defer func() { p.elements = p.elements[:base] }()
+	p.i++
+	p.space()
+	if p.i < len(p.data) && p.data[p.i] == ']' {
+		p.i++
+		return p.arrayOf(base), nil
+	}
+	for {
+		v, err := p.value(depth)
+		if err != nil {
+			return nil, err
+		}
+		if !p.skip {
+			p.elements = append(p.elements, v)
+		}
+		p.space()
+		if p.i < len(p.data) && p.data[p.i] == ',' {
+			p.i++
+			p.space()
+			continue
+		}
+		if p.i < len(p.data) && p.data[p.i] == ']' {
+			p.i++
+			return p.arrayOf(base), nil
+		}
+		return nil, p.fail("after array element")
+	}
+}
+
+// arrayOf returns a copy of the elements read since base.
+func (p *parser) arrayOf(base int) any {
+	if p.skip {
+		return nil
+	}
+	return append([]any{}, p.elements[base:]...)
+}
+
+// str reads the string at p.i.
+func (p *parser) str() (string, error) {
+	start := p.i
+	j := start + 1
+	j += plainRun(p.data[j:])
+	if j < len(p.data) && p.data[j] == '"' {
+		p.i = j + 1
+		if p.skip {
+			return "", nil
+		}
+		return string(p.data[start+1 : j]), nil
+	}
+
+	escaped, ascii := false, true
+	for ; j < len(p.data); j++ {
+		c := p.data[j]
+		switch {
+		case c == '"':
+			p.i = j + 1
+			if p.skip {
+				return "", nil
+			}
+			raw := p.data[start+1 : j]
+			if !escaped && (ascii || utf8.Valid(raw)) {
+				return string(raw), nil
+			}
+			// Escapes and invalid UTF-8 are rare: leave them to encoding/json.
+			var s string
+			if err := json.Unmarshal(p.data[start:p.i], &s); err != nil {
+				return "", err
+			}
+			return s, nil
+		case c < 0x20:
+			p.i = j
+			return "", p.fail("in string literal")
+		case c >= utf8.RuneSelf:
+			ascii = false
+		case c == '\\':
+			escaped = true
+			j++
+			if j == len(p.data) {
+				break
+			}
+			switch p.data[j] {
+			case '"', '\\', '/', 'b', 'f', 'n', 'r', 't':
+			case 'u':
+				for k := 0; k < 4; k++ {
+					if j++; j == len(p.data) || !isHex(p.data[j]) {
+						p.i = j
+						return "", p.fail("in \\u hexadecimal character escape")
+					}
+				}
+			default:
+				p.i = j
+				return "", p.fail("in string escape code")
+			}
+		}
+	}
+	p.i = len(p.data)
+	return "", p.fail("")
+}
+
+func isHex(c byte) bool {
+	return c >= '0' && c <= '9' || c >= 'a' && c <= 'f' || c >= 'A' && c <= 'F'
+}
+
+func (p *parser) number() (any, error) {
+	start := p.i
+	if p.data[p.i] == '-' {
+		p.i++
+	}
+	switch {
+	case p.i < len(p.data) && p.data[p.i] == '0':
+		p.i++
+	case p.i < len(p.data) && p.data[p.i] >= '1' && p.data[p.i] <= '9':
+		p.digits()
+	default:
+		return nil, p.fail("in numeric literal")
+	}
+	if p.i < len(p.data) && p.data[p.i] == '.' {
+		p.i++
+		if p.digits() == 0 {
+			return nil, p.fail("after decimal point in numeric literal")
+		}
+	}
+	if p.i < len(p.data) && (p.data[p.i] == 'e' || p.data[p.i] == 'E') {
+		p.i++
+		if p.i < len(p.data) && (p.data[p.i] == '+' || p.data[p.i] == '-') {
+			p.i++
+		}
+		if p.digits() == 0 {
+			return nil, p.fail("in exponent of numeric literal")
+		}
+	}
+	if p.skip {
+		return nil, nil
+	}
+	if !p.numbers && p.i-start < 16 {
+		// Integers below 10^15 are exact in a float64: skip the conversion to a string.
+		if f, ok := integer(p.data[start:p.i]); ok {
+			return f, nil
+		}
+	}
+	text := string(p.data[start:p.i])
+	if p.numbers {
+		return json.Number(text), nil
+	}
+	f, err := strconv.ParseFloat(text, 64)
+	if err != nil {
+		return nil, fmt.Errorf("cannot unmarshal number %s into Go value of type float64", text)
+	}
+	return f, nil
+}
+
+func integer(b []byte) (float64, bool) {
+	neg := b[0] == '-'
+	if neg {
+		b = b[1:]
+	}
+	n := int64(0)
+	for _, c := range b {
+		if c < '0' || c > '9' {
+			return 0, false
+		}
+		n = n*10 + int64(c-'0')
+	}
+	if neg {
+		if n == 0 {
+			return math.Copysign(0, -1), true
+		}
+		n = -n
+	}
+	return float64(n), true
+}
+
+func (p *parser) digits() int {
+	start := p.i
+	for p.i < len(p.data) && p.data[p.i] >= '0' && p.data[p.i] <= '9' {
+		p.i++
+	}
+	return p.i - start
+}
+
+const (
+	lsb = 0x0101010101010101
+	msb = 0x8080808080808080
+)
+
+// plainRun returns the length of the leading bytes of s that a string holds as is: neither
+// a quote, a backslash, a control character nor a non-ASCII byte. Eight bytes are tested
+// at once, the lowest special byte being the first one set in the mask.
+func plainRun(s []byte) int {
+	n := 0
+	for len(s)-n >= 8 {
+		x := binary.LittleEndian.Uint64(s[n:])
+		q := x ^ (lsb * '"')
+		b := x ^ (lsb * '\\')
+		t := ((q-lsb)&^q | (b-lsb)&^b | (x-lsb*0x20)&^x | x) & msb
+		if t != 0 {
+			return n + bits.TrailingZeros64(t)/8
+		}
+		n += 8
+	}
+	for n < len(s) {
+		if c := s[n]; c == '"' || c == '\\' || c < 0x20 || c >= utf8.RuneSelf {
+			break
+		}
+		n++
+	}
+	return n
+}
@@ -0,0 +1,100 @@
+package meow
+
+import (
+	"bytes"
+	"encoding/json"
+	"reflect"
+	"strings"
+	"testing"
+)
+
+var decoderValues = []string{
+	`{}`, `[]`, `""`, `0`, `-0`, `1.5e3`, `-12.25E-2`, `123456789012345678901`, `true`, `false`, `null`,
+	` {"a": [1, "x", {"b": null}], "a": 2} `, `"plain text of more than eight bytes"`,
+	`"esc\"aped \\ \/ \b\f\n\r\t é 😀"`, `"héllo é wörld"`, "\"bad \xff utf8\"",
+	`{"k1": 1, "long key with spaces": {"long key with spaces": 2}}`, `[[[[[]]]]]`,
+}
+
+var decoderInvalid = []string{
+	``, ` `, `{`, `}`, `[1,]`, `{"a":1,}`, `{"a" 1}`, `{a: 1}`, `01`, `1.`, `.5`, `-`, `1e`, `1e+`,
+	`tru`, `nul`, `"abc`, "\"a\tb\"", `"\x"`, `"\u12g4"`, `{"a":1} x`, `[1 2]`, `1e999`,
+	strings.Repeat("[", 10001) + strings.Repeat("]", 10001),
+}
+
+func TestFastDecoder(t *testing.T) {
+
+	for _, numbers := range []bool{false, true} {
+		for _, s := range decoderValues {
+			expected, err := StdDecoder{}.Decode([]byte(s), numbers)
+			if err != nil {
+				t.Fatalf("Error: %s: %s", s, err)
+			}
+			v, err := FastDecoder{}.Decode([]byte(s), numbers)
+			if err != nil || !reflect.DeepEqual(v, expected) {
+				t.Errorf("Error: %s: found %#v (%v), expected %#v", s, v, err, expected)
+			}
+			if !(FastDecoder{}).Valid([]byte(s)) {
+				t.Errorf("Error: %s: not valid", s)
+			}
+		}
+	}
+	for _, s := range decoderInvalid {
+		if _, err := (FastDecoder{}).Decode([]byte(s), false); err == nil {
+			t.Errorf("Error: %s: no error", s)
+		}
+		if (FastDecoder{}).Valid([]byte(s)) != json.Valid([]byte(s)) {
+			t.Errorf("Error: %s: validity differs", s)
+		}
+	}
+
+	for _, doc := range [][]byte{[]byte(body), synthetic(2000, 40)} {
+		appid := "chess"
+		if !bytes.Contains(doc, []byte(`"chess"`)) {
+			appid = "app"
+		}
+		for _, opts := range [][]Option{nil, {WithNumbers()}, {WithDeepMerge(), WithLazy()}} {
+			expected, err := LoadReader(appid, bytes.NewReader(doc), opts...)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			meow, err := LoadReader(appid, bytes.NewReader(doc), append(opts, WithDecoder(FastDecoder{}))...)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			if !reflect.DeepEqual(meow.Value(), expected.Value()) {
+				t.Errorf("Error: %d options: results differ", len(opts))
+			}
+		}
+	}
+}
+
+func TestPlainRun(t *testing.T) {
+
+	for _, special := range []byte{'"', '\\', 0, 0x1f, 0x80, 0xff} {
+		for n := 0; n < 20; n++ {
+			s := append(bytes.Repeat([]byte{'a'}, n), special, 'b', '"')
+			if found := plainRun(s); found != n {
+				t.Errorf("Error: %q: found %d, expected %d", s, found, n)
+			}
+		}
+	}
+	if found := plainRun([]byte(" !#[]~")); found != 6 {
+		t.Errorf("Error: found %d", found)
+	}
+}
+
+func FuzzFastDecoder(f *testing.F) {
+	for _, s := range append(decoderValues, decoderInvalid[:len(decoderInvalid)-1]...) {
+		f.Add([]byte(s))
+	}
+	f.Fuzz(func(t *testing.T, data []byte) {
+		if (FastDecoder{}).Valid(data) != json.Valid(data) {
+			t.Fatalf("Error: %q: validity differs", data)
+		}
+		expected, err1 := StdDecoder{}.Decode(data, false)
+		v, err2 := FastDecoder{}.Decode(data, false)
+		if (err1 == nil) != (err2 == nil) || !reflect.DeepEqual(v, expected) {
+			t.Fatalf("Error: %q: found %#v (%v), expected %#v (%v)", data, v, err2, expected, err1)
+		}
+	})
+}
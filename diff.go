@@ -0,0 +1,189 @@
+package meow
+
+import (
+	"encoding/binary"
+	"encoding/json"
+	"hash/maphash"
+	"math"
+	"reflect"
+	"sort"
+	"strings"
+	"sync/atomic"
+)
+
+// generations numbers the meows in the order they are built.
+var generations atomic.Uint64
+
+// digestSeed is shared by all the meows, so their digests compare.
+var digestSeed = maphash.MakeSeed()
+
+// Generation returns the generation number of the meow. Every load builds a meow with a
+// higher generation than all the meows built before it in the process.
+func (meow *Meow) Generation() uint64 {
+	return meow.generation
+}
+
+// Diff returns the sequences of keys whose values differ between two meows, sorted. A
+// changed nested object yields the keys that changed within it, a key added or removed
+// yields its own sequence. A nil meow has no keys.
+//
+// The comparison goes through content hashes of every subtree, computed once per meow
+// on its first Diff. The hashes of the subtrees a meow shares with old, the values kept
+// by an incremental reload or by a deep merge, are reused, so diffing each new meow
+// against the previous one costs in proportion to what changed. Under WithLazy, Diff
+// decodes the values it compares.
+func Diff(old, new *Meow) [][]string {
+	if old == new {
+		return nil
+	}
+	var od, nd *digest
+	var om, nm map[string]any
+	if old != nil {
+		od = old.digest(nil)
+		om, _ = od.value.(map[string]any)
+	}
+	if new != nil {
+		nd = new.digest(old)
+		nm, _ = nd.value.(map[string]any)
+	}
+	var paths [][]string
+	diffObject(nil, om, nm, od, nd, &paths)
+	sort.Slice(paths, func(i, j int) bool {
+		return strings.Join(paths[i], pathSep) < strings.Join(paths[j], pathSep)
+	})
+	return paths
+}
+
+// digest is the content hash of a value and, for an object, of its members.
+type digest struct {
+	value any
+	sum   uint64
+	kids  map[string]*digest
+}
+
+// digest returns the digest of the meow, built on first call with the digests of hint
+// for the values shared with it.
+func (meow *Meow) digest(hint *Meow) *digest {
+	// The digest of hint is built first, so no two meows are ever built one within the other.
+	var h *digest
+	if hint != nil {
+		h = hint.digest(nil)
+	}
+	meow.digested.Do(func() {
+		meow.digests = digestOf(meow.tree(), h)
+	})
+	return meow.digests
+}
+
+// tree returns the merged map, built from the arena with WithArena.
+func (meow *Meow) tree() map[string]any {
+	if meow.arena != nil || meow.overlay != nil {
+		return meow.root()
+	}
+	return meow.meow
+}
+
+func diffObject(path []string, om, nm map[string]any, od, nd *digest, paths *[][]string) {
+	at := func(k string) []string {
+		return append(append(make([]string, 0, len(path)+1), path...), k)
+	}
+	for k, nv := range nm {
+		ov, ok := om[k]
+		if !ok {
+			*paths = append(*paths, at(k))
+			continue
+		}
+		okd, nkd := od.kids[k], nd.kids[k]
+		if same(ov, nv) || okd.sum == nkd.sum {
+			continue
+		}
+		if okd.kids != nil && nkd.kids != nil {
+			diffObject(at(k), resolve(ov).(map[string]any), resolve(nv).(map[string]any), okd, nkd, paths)
+			continue
+		}
+		*paths = append(*paths, at(k))
+	}
+	for k := range om {
+		if _, ok := nm[k]; !ok {
+			*paths = append(*paths, at(k))
+		}
+	}
+}
+
+// digestOf returns the digest of v, reusing hint, the digest of an older value, when v is
+// the very same object.
+func digestOf(v any, hint *digest) *digest {
+	if hint != nil && same(v, hint.value) {
+		return hint
+	}
+	d := &digest{value: v}
+	obj, ok := resolve(v).(map[string]any)
+	if !ok {
+		d.sum = sumOf(resolve(v))
+		return d
+	}
+	d.kids = make(map[string]*digest, len(obj))
+	d.sum = 'o'
+	var buf [16]byte
+	for k, c := range obj {
+		var h *digest
+		if hint != nil {
+			h = hint.kids[k]
+		}
+		kd := digestOf(c, h)
+		d.kids[k] = kd
+		// Members are summed, so that the order of the map does not matter.
+		binary.LittleEndian.PutUint64(buf[:8], maphash.String(digestSeed, k))
+		binary.LittleEndian.PutUint64(buf[8:], kd.sum)
+		d.sum += maphash.Bytes(digestSeed, buf[:])
+	}
+	return d
+}
+
+// sumOf hashes a value that is not an object.
+func sumOf(v any) uint64 {
+	var h maphash.Hash
+	h.SetSeed(digestSeed)
+	var buf [8]byte
+	switch v := v.(type) {
+	case nil:
+		h.WriteByte('z')
+	case bool:
+		if v {
+			h.WriteByte('t')
+		} else {
+			h.WriteByte('f')
+		}
+	case float64:
+		h.WriteByte('n')
+		binary.LittleEndian.PutUint64(buf[:], math.Float64bits(v))
+		h.Write(buf[:])
+	case json.Number:
+		h.WriteByte('j')
+		h.WriteString(string(v))
+	case string:
+		h.WriteByte('s')
+		h.WriteString(v)
+	case []any:
+		h.WriteByte('a')
+		for _, e := range v {
+			binary.LittleEndian.PutUint64(buf[:], digestOf(e, nil).sum)
+			h.Write(buf[:])
+		}
+	default:
+		h.WriteByte('?')
+	}
+	return h.Sum64()
+}
+
+// same reports whether a and b are the very same object, shared by two meows.
+func same(a, b any) bool {
+	switch a := a.(type) {
+	case map[string]any:
+		b, ok := b.(map[string]any)
+		return ok && reflect.ValueOf(a).UnsafePointer() == reflect.ValueOf(b).UnsafePointer()
+	case *lazyValue:
+		return a == b
+	}
+	return false
+}
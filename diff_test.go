@@ -0,0 +1,76 @@
+package meow
+
+import (
+	"hash/maphash"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+)
+
+func TestDiff(t *testing.T) {
+
+	oldDoc := `{
+		"base": {"meow-score": 1, "g": {"x": 1, "y": {"z": 1}, "w": {"v": 1}}, "s": "v", "gone": 1},
+		"chess": {"k": [1, 2], "t": {"u": 1}}
+	}`
+	newDoc := `{
+		"base": {"meow-score": 1, "g": {"x": 1, "y": {"z": 2}, "w": 1}, "s": "v", "added": null},
+		"chess": {"k": [1, 3], "t": {"u": 1}}
+	}`
+	expected := [][]string{{"added"}, {"g", "w"}, {"g", "y", "z"}, {"gone"}, {"k"}}
+	for _, opts := range [][]Option{nil, {WithLazy()}, {WithDeepMerge()}, {WithNumbers(), WithDecoder(FastDecoder{})}} {
+		old, err := LoadReader("chess", strings.NewReader(oldDoc), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		new, err := LoadReader("chess", strings.NewReader(newDoc), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		if new.Generation() <= old.Generation() {
+			t.Errorf("Error: generation %d after %d", new.Generation(), old.Generation())
+		}
+		if found := Diff(old, new); !reflect.DeepEqual(found, expected) {
+			t.Errorf("Error: %d options: found %v, expected %v", len(opts), found, expected)
+		}
+		same, err := LoadReader("chess", strings.NewReader(oldDoc), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		if found := Diff(old, same); len(found) != 0 || Diff(old, old) != nil {
+			t.Errorf("Error: %d options: found %v for the same content", len(opts), found)
+		}
+	}
+
+	meow, err := LoadReader("chess", strings.NewReader(oldDoc))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if found := Diff(nil, meow); len(found) != 6 {
+		t.Errorf("Error: found %v", found)
+	}
+
+	// The digests of the values kept by an incremental reload are reused.
+	meowFile := filepath.Join(t.TempDir(), "meow.json")
+	src := &fileSource{appid: "chess", meowFile: meowFile, o: newOptions(nil), seed: maphash.MakeSeed()}
+	os.WriteFile(meowFile, []byte(body), 0o600)
+	old, err := src.load()
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	os.WriteFile(meowFile, []byte(strings.Replace(body, `"key-test1": "branch1 general3"`, `"key-test1": "changed"`, 1)), 0o600)
+	new, err := src.load()
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if found := Diff(old, new); !reflect.DeepEqual(found, [][]string{{"key-test1"}}) {
+		t.Errorf("Error: found %v", found)
+	}
+	for k, d := range new.digest(nil).kids {
+		if k != "key-test1" && same(old.meow[k], new.meow[k]) && d != old.digest(nil).kids[k] {
+			t.Errorf("Error: digest of `%s` not reused", k)
+		}
+	}
+}
@@ -0,0 +1,302 @@
+package meow
+
+import (
+	"fmt"
+	"hash/maphash"
+	"os"
+	"path/filepath"
+	"runtime"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// LoadFiles loads the meow for an application appid from several files, such as a base file
+// and per-region fragments. Every entry of meowFiles is a file name or a pattern of
+// filepath.Glob, expanded in lexical order. The top-level values of all the files take part
+// in a single merge by `meow-score`: the appid layers of the files are merged first, in the
+// order of the files, a later file taking precedence. The files are decoded concurrently.
+func LoadFiles(appid string, meowFiles []string, opts ...Option) (*Meow, error) {
+	src, err := newFilesSource(appid, meowFiles, newOptions(opts))
+	if err != nil {
+		return nil, err
+	}
+	return src.load()
+}
+
+// WatchFiles loads the meow for an application appid from several files, see LoadFiles, and
+// watches them for changes, see WatchFile. The patterns are expanded again on every reload,
+// so new fragments are picked up; only the files whose content changed are decoded again.
+func WatchFiles(appid string, meowFiles []string, interval time.Duration, opts ...Option) (*Watcher, error) {
+	src, err := newFilesSource(appid, meowFiles, newOptions(opts))
+	if err != nil {
+		return nil, err
+	}
+	if interval <= 0 {
+		interval = time.Second
+	}
+	reg, err := NewRegistry(src.load)
+	if err != nil {
+		return nil, err
+	}
+	events, cancel := notifyAll(meowFiles)
+	return startWatcher(reg, src.o, events, cancel, interval, src.notify), nil
+}
+
+// filesSource loads a meow from a list of files. It remembers the size, modification time,
+// content hash and decoded layers of every file: a reload reads again the files whose size
+// or modification time changed and decodes again those whose content changed.
+type filesSource struct {
+	appid     string
+	meowFiles []string
+	o         *options
+	seed      maphash.Seed
+	notified  atomic.Bool
+
+	names []string
+	files map[string]*fragment
+}
+
+// fragment is a file of a filesSource with its decoded top-level values.
+type fragment struct {
+	size  int64
+	mtime time.Time
+	sum   uint64
+	spans []fragmentSpan
+}
+
+type fragmentSpan struct {
+	key    string
+	layer  layer
+	scored bool
+}
+
+func newFilesSource(appid string, meowFiles []string, o *options) (*filesSource, error) {
+	if appid == "" {
+		return nil, fmt.Errorf("meow identification is empty")
+	}
+	if len(meowFiles) == 0 {
+		return nil, fmt.Errorf("no meow file specified")
+	}
+	for _, p := range meowFiles {
+		if p == "" {
+			return nil, fmt.Errorf("no meow file specified")
+		}
+		if _, err := filepath.Match(p, ""); err != nil {
+			return nil, fmt.Errorf("invalid meow file pattern `%s`: %s", p, err)
+		}
+	}
+	return &filesSource{appid: appid, meowFiles: meowFiles, o: o, seed: maphash.MakeSeed()}, nil
+}
+
+// expand returns the files of the patterns, each once, in the order of the patterns.
+func (s *filesSource) expand() ([]string, error) {
+	var names []string
+	seen := make(map[string]bool)
+	for _, p := range s.meowFiles {
+		matches := []string{p}
+		if strings.ContainsAny(p, `*?[\`) {
+			matches, _ = filepath.Glob(p)
+		}
+		for _, name := range matches {
+			if !seen[name] {
+				seen[name] = true
+				names = append(names, name)
+			}
+		}
+	}
+	if len(names) == 0 {
+		return nil, fmt.Errorf("no meow file matches `%s`", strings.Join(s.meowFiles, "`, `"))
+	}
+	return names, nil
+}
+
+// notify makes the next load read every file whatever its size and modification time, see
+// fileSource.notify.
+func (s *filesSource) notify() {
+	s.notified.Store(true)
+}
+
+// load returns the meow of the files, or nil when neither the list of files nor the content
+// of a file changed.
+func (s *filesSource) load() (*Meow, error) {
+	notified := s.notified.Swap(false)
+	names, err := s.expand()
+	if err != nil {
+		return nil, err
+	}
+	stats := make([]os.FileInfo, len(names))
+	for i, name := range names {
+		if stats[i], err = os.Stat(name); err != nil {
+			return nil, fmt.Errorf("error at opening meow file `%s`: %s", name, err)
+		}
+	}
+
+	changed := s.files == nil || len(names) != len(s.names)
+	for i := 0; !changed && i < len(names); i++ {
+		changed = names[i] != s.names[i]
+	}
+	files := make([]*fragment, len(names))
+	errs := make([]error, len(names))
+	var wg sync.WaitGroup
+	slots := make(chan struct{}, runtime.GOMAXPROCS(0))
+	for i, name := range names {
+		f := s.files[name]
+		if f != nil && !notified && f.size == stats[i].Size() && f.mtime.Equal(stats[i].ModTime()) {
+			files[i] = f
+			continue
+		}
+		wg.Add(1)
+		slots <- struct{}{}
+		go func(i int, name string, old *fragment) {
+			defer wg.Done()
+			files[i], errs[i] = s.read(name, stats[i], old)
+			<-slots
+		}(i, name, f)
+	}
+	wg.Wait()
+	for i, err := range errs {
+		if err != nil {
+			return nil, err
+		}
+		if old := s.files[names[i]]; old == nil || files[i].sum != old.sum {
+			changed = true
+		}
+	}
+
+	cache := make(map[string]*fragment, len(names))
+	for i, name := range names {
+		cache[name] = files[i]
+	}
+	if !changed {
+		s.files = cache
+		return nil, nil
+	}
+	merged, err := s.merge(names, files)
+	if err != nil {
+		return nil, err
+	}
+	meow, err := newMeow(s.appid, merged, s.o)
+	if err != nil {
+		return nil, err
+	}
+	s.names, s.files = names, cache
+	return meow, nil
+}
+
+// read decodes a file, or keeps the values of old when the content is the same.
+func (s *filesSource) read(name string, fi os.FileInfo, old *fragment) (*fragment, error) {
+	data, err := os.ReadFile(name)
+	if err != nil {
+		return nil, fmt.Errorf("error at opening meow file `%s`: %s", name, err)
+	}
+	f := &fragment{size: fi.Size(), mtime: fi.ModTime(), sum: maphash.Bytes(s.seed, data)}
+	if old != nil && old.sum == f.sum {
+		f.spans = old.spans
+		return f, nil
+	}
+	o := s.o.forDocument(data)
+	spans, err := o.split(data)
+	if err == nil {
+		err = validJSON(data, o)
+	}
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow file `%s`: %s", name, err)
+	}
+	f.spans = make([]fragmentSpan, 0, len(spans))
+	for _, sp := range spans {
+		mw, scored, err := decodeSpan(data[sp.start:sp.end], sp.key == s.appid, o)
+		if err != nil {
+			return nil, fmt.Errorf("error at handling meow file `%s`: does not contain a valid JSON object: %s", name, err)
+		}
+		if !scored && sp.key != s.appid {
+			// Kept without its value: it still replaces a layer of the same name, see merge.
+			mw = layer{}
+		}
+		f.spans = append(f.spans, fragmentSpan{sp.key, mw, scored})
+	}
+	// The last appid layer of the file is the one merged, see merge.
+	for i := len(f.spans) - 1; i >= 0; i-- {
+		if sp := f.spans[i]; sp.key == s.appid {
+			if sp.layer.value == nil {
+				return nil, fmt.Errorf("error at handling meow file `%s`: `%s` is not a JSON object", name, s.appid)
+			}
+			break
+		}
+	}
+	return f, nil
+}
+
+// merge merges the values of the files given in the order of the patterns.
+func (s *filesSource) merge(names []string, files []*fragment) (map[string]any, error) {
+	set := layerSet{appid: s.appid}
+	var apps []layer
+	for _, f := range files {
+		set.next()
+		app := -1
+		for i, sp := range f.spans {
+			if sp.key == s.appid {
+				app = i
+				continue
+			}
+			if err := set.add(sp.key, sp.layer, sp.scored); err != nil {
+				return nil, err
+			}
+		}
+		if app >= 0 {
+			apps = append(apps, f.spans[app].layer)
+		}
+	}
+	switch len(apps) {
+	case 0:
+	case 1:
+		set.add(s.appid, apps[0], false)
+	default:
+		set.add(s.appid, layer{value: mergeLayers(apps, s.o.deep)}, false)
+	}
+	mews, err := set.ordered()
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow files `%s`: %s", strings.Join(names, "`, `"), err)
+	}
+	return mergeLayers(mews, s.o.deep), nil
+}
+
+// notifyAll signals changes in the directories of the patterns, see notify.
+func notifyAll(meowFiles []string) (<-chan struct{}, func()) {
+	events := make(chan struct{}, 1)
+	var cancels []func()
+	var wg sync.WaitGroup
+	seen := make(map[string]bool)
+	for _, p := range meowFiles {
+		dir := filepath.Dir(p)
+		if seen[dir] || strings.ContainsAny(dir, `*?[\`) {
+			continue
+		}
+		seen[dir] = true
+		ch, cancel := notify(p)
+		cancels = append(cancels, cancel)
+		if ch == nil {
+			continue
+		}
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for range ch {
+				select {
+				case events <- struct{}{}:
+				default:
+				}
+			}
+		}()
+	}
+	go func() {
+		wg.Wait()
+		close(events)
+	}()
+	return events, func() {
+		for _, cancel := range cancels {
+			cancel()
+		}
+	}
+}
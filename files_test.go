@@ -0,0 +1,131 @@
+package meow
+
+import (
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestLoadFiles(t *testing.T) {
+
+	dir := t.TempDir()
+	write := func(name, content string, age time.Duration) {
+		t.Helper()
+		name = filepath.Join(dir, name)
+		os.MkdirAll(filepath.Dir(name), 0o700)
+		if err := os.WriteFile(name, []byte(content), 0o600); err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		os.Chtimes(name, time.Now(), time.Now().Add(age))
+	}
+	write("base.json", body, 0)
+	write("region/eu.json", `{"eu": {"meow-score": 20, "region": "eu", "string": "EU"}, "chess": {"int": 2}}`, 0)
+	write("region/us.json", `{"us": {"meow-score": 5, "region": "us", "key-test1": "us"}, "general1": {"skipped": 1}}`, 0)
+
+	patterns := []string{filepath.Join(dir, "base.json"), filepath.Join(dir, "region", "*.json")}
+	meow, err := LoadFiles("chess", patterns)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	for _, c := range []struct {
+		key      []string
+		expected any
+	}{
+		{[]string{"region"}, "eu"},
+		{[]string{"string"}, "S"},
+		{[]string{"int"}, float64(2)},
+		{[]string{"key-test1"}, "branch1 general3"},
+		{[]string{"slice-string"}, []any{"a", "b"}},
+	} {
+		if found := meow.Value(c.key...); !reflect.DeepEqual(found, c.expected) {
+			t.Errorf("Error: %v: found `%v`, expected `%v`", c.key, found, c.expected)
+		}
+	}
+
+	src, err := newFilesSource("chess", patterns, newOptions(nil))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if _, err := src.load(); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	base := src.files[filepath.Join(dir, "base.json")]
+	write("region/us.json", `{"us": {"meow-score": 5, "region": "us", "key-test1": "us"}, "general1": {"skipped": 1}}`, time.Second)
+	write("base.json", body, time.Second)
+	if meow, err := src.load(); meow != nil || err != nil {
+		t.Errorf("Error: reloaded unchanged content")
+	}
+	write("region/eu.json", `{"eu": {"meow-score": 20, "region": "eu2"}}`, 2*time.Second)
+	write("region/ap.json", `{"ap": {"meow-score": 30, "region": "ap"}}`, 0)
+	meow, err = src.load()
+	if err != nil || meow == nil {
+		t.Fatalf("Error: no reload: %v", err)
+	}
+	if found := meow.ValueString("region"); found != "ap" {
+		t.Errorf("Error: found `%s`", found)
+	}
+	if found := meow.ValueInt("int"); found != 1 {
+		t.Errorf("Error: found `%d`", found)
+	}
+	if reused := src.files[filepath.Join(dir, "base.json")]; reused.spans[0].layer.value == nil ||
+		reflect.ValueOf(reused.spans[0].layer.value).Pointer() != reflect.ValueOf(base.spans[0].layer.value).Pointer() {
+		t.Errorf("Error: unchanged file decoded again")
+	}
+
+	us := filepath.Join(dir, "region", "us.json")
+	fi, _ := os.Stat(us)
+	write("region/us.json", `{"us": {"meow-score": 5, "region": "us", "key-test9": "us"}, "general1": {"skipped": 1}}`, 0)
+	os.Chtimes(us, fi.ModTime(), fi.ModTime())
+	if meow, err := src.load(); meow != nil || err != nil {
+		t.Errorf("Error: reloaded an unchanged size and modification time")
+	}
+	src.notify()
+	if meow, err := src.load(); err != nil || meow == nil || meow.ValueString("key-test9") != "us" {
+		t.Errorf("Error: notified rewrite not reloaded: %v", err)
+	}
+
+	os.Remove(filepath.Join(dir, "region", "ap.json"))
+	if meow, err = src.load(); err != nil || meow.ValueString("region") != "eu2" {
+		t.Errorf("Error: removed fragment still merged: %v", err)
+	}
+
+	write("region/eu.json", `{"eu": 1`, 3*time.Second)
+	if _, err := src.load(); err == nil || !strings.Contains(err.Error(), "eu.json") {
+		t.Errorf("Error: found `%v`", err)
+	}
+	for _, c := range [][]string{nil, {""}, {"["}, {filepath.Join(dir, "none", "*.json")}, {filepath.Join(dir, "missing.json")}, {filepath.Join(dir, "region", "us.json")}} {
+		if _, err := LoadFiles("chess", c); err == nil {
+			t.Errorf("Error: no error for %v", c)
+		}
+	}
+}
+
+func TestWatchFiles(t *testing.T) {
+
+	dir := t.TempDir()
+	if err := os.WriteFile(filepath.Join(dir, "base.json"), []byte(`{"chess": {"n": 1}}`), 0o600); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	w, err := WatchFiles("chess", []string{filepath.Join(dir, "*.json")}, 10*time.Millisecond)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	defer w.Close()
+
+	published := make(chan *Meow, 4)
+	w.Registry().Subscribe(func(old, new *Meow) { published <- new })
+	if err := os.WriteFile(filepath.Join(dir, "x.json"), []byte(`{"x": {"meow-score": 1, "n": 0, "m": 2}}`), 0o600); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	select {
+	case meow := <-published:
+		if meow.ValueInt("n") != 1 || meow.ValueInt("m") != 2 {
+			t.Errorf("Error: found `%v`", meow.meow)
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatalf("Error: new fragment not picked up")
+	}
+}
@@ -0,0 +1,97 @@
+package meow
+
+import (
+	"encoding/json"
+	"math/big"
+	"strconv"
+)
+
+// splitter is a Decoder of a binary encoding, such as MessagePack and CBOR, which splits the
+// top-level map of a document into spans of its own encoding instead of JSON spans.
+type splitter interface {
+	Decoder
+	split(data []byte) ([]span, error)
+	// object reports whether a value starting with c is a map.
+	object(c byte) bool
+}
+
+// split returns the spans of the top-level values of a document, see splitDocument.
+func (o *options) split(data []byte) ([]span, error) {
+	if s, ok := o.decoder.(splitter); ok {
+		return s.split(data)
+	}
+	return splitDocument(data)
+}
+
+// object reports whether raw, a value of a document, is an object.
+func (o *options) object(raw []byte) bool {
+	if len(raw) == 0 {
+		return false
+	}
+	if s, ok := o.decoder.(splitter); ok {
+		return s.object(raw[0])
+	}
+	return raw[0] == '{'
+}
+
+// detectFormat returns the decoder of a binary document starting with c: a MessagePack map,
+// a CBOR map or a CBOR tag, such as the self-described CBOR tag. It returns nil for JSON,
+// which never starts with these bytes.
+func detectFormat(c byte) Decoder {
+	switch {
+	case c >= 0x80 && c <= 0x8f, c == 0xde, c == 0xdf:
+		return MessagePack{}
+	case c >= 0xa0 && c <= 0xbf, c >= 0xc0 && c <= 0xdb:
+		return CBOR{}
+	}
+	return nil
+}
+
+// forDocument returns the options to decode data with: the options themselves, or a copy
+// with the decoder of the binary encoding of data when no decoder was given.
+func (o *options) forDocument(data []byte) *options {
+	if o.decoder != nil || len(data) == 0 {
+		return o
+	}
+	d := detectFormat(data[0])
+	if d == nil {
+		return o
+	}
+	c := *o
+	c.decoder = d
+	return &c
+}
+
+// number returns an integer of a binary encoding as encoding/json would decode it.
+func number(i int64, numbers bool) any {
+	if numbers {
+		return json.Number(strconv.FormatInt(i, 10))
+	}
+	return float64(i)
+}
+
+func unsigned(u uint64, numbers bool) any {
+	if numbers {
+		return json.Number(strconv.FormatUint(u, 10))
+	}
+	return float64(u)
+}
+
+// negative returns the integer -1-n, which may not fit in an int64.
+func negative(n uint64, numbers bool) any {
+	if n <= 1<<63-1 {
+		return number(-1-int64(n), numbers)
+	}
+	if numbers {
+		i := new(big.Int).SetUint64(n)
+		return json.Number(i.Neg(i.Add(i, big.NewInt(1))).String())
+	}
+	return -1 - float64(n)
+}
+
+func float(f float64, numbers bool) any {
+	if numbers {
+		return json.Number(strconv.FormatFloat(f, 'g', -1, 64))
+	}
+	return f
+}
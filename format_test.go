@@ -0,0 +1,293 @@
+package meow
+
+import (
+	"bytes"
+	"encoding/binary"
+	"encoding/json"
+	"math"
+	"os"
+	"path/filepath"
+	"reflect"
+	"sort"
+	"strings"
+	"testing"
+)
+
+// encodeMsgpack encodes a decoded JSON value with MessagePack. Whole numbers become integers.
+func encodeMsgpack(b []byte, v any) []byte {
+	length := func(b []byte, n int, fix, base byte) []byte {
+		switch {
+		case n < 16 && fix != 0 || n < 32 && fix == 0xa0:
+			return append(b, fix|byte(n))
+		case n < 1<<16:
+			return binary.BigEndian.AppendUint16(append(b, base), uint16(n))
+		}
+		return binary.BigEndian.AppendUint32(append(b, base+1), uint32(n))
+	}
+	switch v := v.(type) {
+	case nil:
+		return append(b, 0xc0)
+	case bool:
+		if v {
+			return append(b, 0xc3)
+		}
+		return append(b, 0xc2)
+	case float64:
+		if v == math.Trunc(v) && math.Abs(v) < 1<<53 {
+			return binary.BigEndian.AppendUint64(append(b, 0xd3), uint64(int64(v)))
+		}
+		return binary.BigEndian.AppendUint64(append(b, 0xcb), math.Float64bits(v))
+	case string:
+		return append(length(b, len(v), 0xa0, 0xda), v...)
+	case []any:
+		b = length(b, len(v), 0x90, 0xdc)
+		for _, e := range v {
+			b = encodeMsgpack(b, e)
+		}
+		return b
+	case map[string]any:
+		b = length(b, len(v), 0x80, 0xde)
+		for _, k := range sortedMapKeys(v) {
+			b = encodeMsgpack(encodeMsgpack(b, k), v[k])
+		}
+		return b
+	}
+	panic(v)
+}
+
+// encodeCBOR encodes a decoded JSON value with CBOR. Whole numbers become integers, arrays
+// have indefinite lengths to cover both forms.
+func encodeCBOR(b []byte, v any) []byte {
+	head := func(b []byte, major byte, n uint64) []byte {
+		switch {
+		case n < 24:
+			return append(b, major<<5|byte(n))
+		case n < 1<<8:
+			return append(b, major<<5|24, byte(n))
+		case n < 1<<16:
+			return binary.BigEndian.AppendUint16(append(b, major<<5|25), uint16(n))
+		case n < 1<<32:
+			return binary.BigEndian.AppendUint32(append(b, major<<5|26), uint32(n))
+		}
+		return binary.BigEndian.AppendUint64(append(b, major<<5|27), n)
+	}
+	switch v := v.(type) {
+	case nil:
+		return append(b, 0xf6)
+	case bool:
+		if v {
+			return append(b, 0xf5)
+		}
+		return append(b, 0xf4)
+	case float64:
+		switch {
+		case v != math.Trunc(v) || math.Abs(v) >= 1<<53:
+			return binary.BigEndian.AppendUint64(append(b, 0xfb), math.Float64bits(v))
+		case v < 0:
+			return head(b, cborNegative, uint64(-1-int64(v)))
+		}
+		return head(b, cborUnsigned, uint64(v))
+	case string:
+		return append(head(b, cborText, uint64(len(v))), v...)
+	case []any:
+		b = append(b, 0x9f)
+		for _, e := range v {
+			b = encodeCBOR(b, e)
+		}
+		return append(b, 0xff)
+	case map[string]any:
+		b = head(b, cborMap, uint64(len(v)))
+		for _, k := range sortedMapKeys(v) {
+			b = encodeCBOR(encodeCBOR(b, k), v[k])
+		}
+		return b
+	}
+	panic(v)
+}
+
+func sortedMapKeys(m map[string]any) []string {
+	keys := make([]string, 0, len(m))
+	for k := range m {
+		keys = append(keys, k)
+	}
+	sort.Strings(keys)
+	return keys
+}
+
+func decodedBody(t testing.TB, data []byte) any {
+	var v any
+	if err := json.Unmarshal(data, &v); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	return v
+}
+
+func TestFormats(t *testing.T) {
+
+	doc := decodedBody(t, []byte(body))
+	formats := map[string][]byte{
+		"msgpack":     encodeMsgpack(nil, doc),
+		"cbor":        encodeCBOR(nil, doc),
+		"cbor-tagged": append([]byte{0xd9, 0xd9, 0xf7}, encodeCBOR(nil, doc)...),
+	}
+	for _, opts := range [][]Option{nil, {WithLazy()}, {WithParallel(4)}, {WithDeepMerge()}} {
+		expected, err := LoadReader("chess", strings.NewReader(body), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		for name, data := range formats {
+			meow, err := LoadReader("chess", bytes.NewReader(data), opts...)
+			if err != nil {
+				t.Fatalf("Error: %s: %s", name, err)
+			}
+			if !reflect.DeepEqual(meow.root(), expected.root()) {
+				t.Errorf("Error: %s: found\n%v\nexpected\n%v", name, meow.root(), expected.root())
+			}
+		}
+	}
+
+	meow, err := LoadReader("chess", bytes.NewReader(formats["cbor"]), WithNumbers())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if found := meow.Value("int"); found != json.Number("1") {
+		t.Errorf("Error: found `%v`", found)
+	}
+	if _, err := LoadReader("chess", strings.NewReader(body), WithDecoder(MessagePack{})); err == nil {
+		t.Errorf("Error: no error for JSON decoded as MessagePack")
+	}
+
+	dir := t.TempDir()
+	os.WriteFile(filepath.Join(dir, "base.msgpack"), formats["msgpack"], 0o600)
+	os.WriteFile(filepath.Join(dir, "region.json"), []byte(`{"eu": {"meow-score": 20, "string": "EU"}}`), 0o600)
+	if meow, err = LoadFiles("chess", []string{filepath.Join(dir, "*")}); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if meow.ValueString("string") != "S" || meow.ValueString("key-test1") != "branch1 general3" {
+		t.Errorf("Error: found `%v`", meow.root())
+	}
+}
+
+func TestBinaryScalars(t *testing.T) {
+
+	for _, c := range []struct {
+		data     []byte
+		expected any
+	}{
+		{[]byte{0x05}, float64(5)},
+		{[]byte{0xff}, float64(-1)},
+		{[]byte{0xd0, 0x80}, float64(-128)},
+		{[]byte{0xcd, 0x01, 0x00}, float64(256)},
+		{[]byte{0xca, 0x3f, 0xc0, 0x00, 0x00}, 1.5},
+		{[]byte{0xc4, 0x02, 'h', 'i'}, "hi"},
+		{[]byte{0xc0}, nil},
+		{[]byte{0xc3}, true},
+	} {
+		if found, err := (MessagePack{}).Decode(c.data, false); err != nil || !reflect.DeepEqual(found, c.expected) {
+			t.Errorf("Error: MessagePack % x: found `%v` `%v`, expected `%v`", c.data, found, err, c.expected)
+		}
+	}
+	for _, c := range []struct {
+		data     []byte
+		expected any
+	}{
+		{[]byte{0x18, 0x64}, float64(100)},
+		{[]byte{0x38, 0x63}, float64(-100)},
+		{[]byte{0xf9, 0x3e, 0x00}, 1.5},
+		{[]byte{0xf9, 0x00, 0x01}, math.Ldexp(1, -24)},
+		{[]byte{0xfa, 0xc0, 0x00, 0x00, 0x00}, float64(-2)},
+		{[]byte{0x7f, 0x62, 'h', 'e', 0x61, 'y', 0xff}, "hey"},
+		{[]byte{0xbf, 0x61, 'a', 0x01, 0xff}, map[string]any{"a": float64(1)}},
+		{[]byte{0xc1, 0x01}, float64(1)},
+		{[]byte{0xf7}, nil},
+		{[]byte{0xf4}, false},
+	} {
+		if found, err := (CBOR{}).Decode(c.data, false); err != nil || !reflect.DeepEqual(found, c.expected) {
+			t.Errorf("Error: CBOR % x: found `%v` `%v`, expected `%v`", c.data, found, err, c.expected)
+		}
+	}
+	if found, _ := (CBOR{}).Decode([]byte{0x3b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, true); found != json.Number("-18446744073709551616") {
+		t.Errorf("Error: found `%v`", found)
+	}
+
+	for _, data := range [][]byte{{}, {0x81, 0x01, 0x01}, {0xc7, 0x01, 0x01, 0x00}, {0xda, 0x00}, {0x05, 0x05}, {0xcb, 0x7f, 0xf8, 0, 0, 0, 0, 0, 0}} {
+		if _, err := (MessagePack{}).Decode(data, false); err == nil {
+			t.Errorf("Error: MessagePack % x accepted", data)
+		}
+	}
+	for _, data := range [][]byte{{}, {0xa1, 0x01, 0x01}, {0xc2, 0x41, 0x01}, {0x1c}, {0xf8, 0x10}, {0x7f, 0x41, 'a', 0xff}, {0xff}, {0xfb, 0x7f, 0xf0, 0, 0, 0, 0, 0, 0}} {
+		if _, err := (CBOR{}).Decode(data, false); err == nil {
+			t.Errorf("Error: CBOR % x accepted", data)
+		}
+	}
+	nan := map[string][]byte{
+		"msgpack": {0x81, 0xa3, 'a', 'p', 'p', 0x81, 0xa1, 'a', 0xcb, 0x7f, 0xf8, 0, 0, 0, 0, 0, 0},
+		"cbor":    {0xa1, 0x63, 'a', 'p', 'p', 0xa1, 0x61, 'a', 0xfb, 0x7f, 0xf8, 0, 0, 0, 0, 0, 0},
+	}
+	for name, data := range nan {
+		if (MessagePack{}).Valid(data) || (CBOR{}).Valid(data) {
+			t.Errorf("Error: %s with NaN is valid", name)
+		}
+		for _, opts := range [][]Option{nil, {WithLazy()}} {
+			if _, err := LoadReader("app", bytes.NewReader(data), opts...); err == nil {
+				t.Errorf("Error: %s with NaN loaded with %d options", name, len(opts))
+			}
+		}
+	}
+	for _, data := range []string{"\xdf\xe9\xef\v\x14{&\"Crc\xb8\x92\x9fCCCCCC'", "\xbb\xff\xff\xff\xff\xff\xff\xff\xff\x61a\x01"} {
+		if _, err := LoadReader("chess", strings.NewReader(data)); err == nil {
+			t.Errorf("Error: map of a huge count % x accepted", data)
+		}
+	}
+	if _, err := LoadReader("chess", bytes.NewReader([]byte{0x81, 0xa5, 'c', 'h', 'e', 's', 's', 0x01})); err == nil {
+		t.Errorf("Error: no error for a scalar appid layer")
+	}
+}
+
+func FuzzBinaryDecoders(f *testing.F) {
+	doc := decodedBody(f, []byte(body))
+	f.Add(encodeMsgpack(nil, doc))
+	f.Add(encodeCBOR(nil, doc))
+	f.Add([]byte{0x7f, 0x62, 'h', 'e', 0x61, 'y', 0xff})
+	f.Add([]byte("\xcb\xff\xff000000"))
+	f.Add([]byte{0xfb, 0x7f, 0xf8, 0, 0, 0, 0, 0, 0})
+	f.Fuzz(func(t *testing.T, data []byte) {
+		for _, d := range []Decoder{MessagePack{}, CBOR{}} {
+			v, err := d.Decode(data, false)
+			if d.Valid(data) != (err == nil) {
+				t.Fatalf("Error: %T % x: validity differs from %v", d, data, err)
+			}
+			if err != nil {
+				continue
+			}
+			if _, err := json.Marshal(v); err != nil {
+				t.Fatalf("Error: %T % x: %#v is not JSON: %s", d, data, v, err)
+			}
+		}
+	})
+}
+
+func BenchmarkFormats(b *testing.B) {
+	data := synthetic(100000, 50)
+	doc := decodedBody(b, data)
+	for _, f := range []struct {
+		name string
+		data []byte
+		opts []Option
+	}{
+		{"json", data, nil},
+		{"json-fast", data, []Option{WithDecoder(FastDecoder{})}},
+		{"msgpack", encodeMsgpack(nil, doc), nil},
+		{"cbor", encodeCBOR(nil, doc), nil},
+	} {
+		b.Run(f.name, func(b *testing.B) {
+			b.SetBytes(int64(len(f.data)))
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := LoadReader("app", bytes.NewReader(f.data), f.opts...); err != nil {
+					b.Fatalf("Error: %s", err)
+				}
+			}
+		})
+	}
+}
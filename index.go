@@ -0,0 +1,90 @@
+package meow
+
+import "strings"
+
+// pathSep joins the keys of a sequence in the flattened index.
+const pathSep = "\x1f"
+
+// index maps every sequence of keys of a meow to a value slot. The joined paths are
+// substrings of a single string, so the index costs one allocation for all its keys. Next
+// to each value, the index holds its conversions to the Scalar types, see Lookup.
+type index struct {
+	paths   map[string]int32
+	slots   []any
+	scalars []scalar
+	depths  []uint16
+}
+
+// buildIndex flattens the nested objects of m. It returns nil when a key contains pathSep,
+// in which case lookups walk the tree.
+func buildIndex(m map[string]any) *index {
+	type entry struct {
+		start, end int
+		depth      int
+		value      any
+	}
+	var arena []byte
+	var entries []entry
+	var walk func(start, end, depth int, m map[string]any) bool
+	walk = func(start, end, depth int, m map[string]any) bool {
+		for k, v := range m {
+			if strings.Contains(k, pathSep) {
+				return false
+			}
+			s := len(arena)
+			if depth > 0 {
+				arena = append(arena, arena[start:end]...)
+				arena = append(arena, pathSep...)
+			}
+			arena = append(arena, k...)
+			e := len(arena)
+			entries = append(entries, entry{s, e, depth + 1, v})
+			if sub, ok := v.(map[string]any); ok && !walk(s, e, depth+1, sub) {
+				return false
+			}
+		}
+		return true
+	}
+	if !walk(0, 0, 0, m) {
+		return nil
+	}
+
+	all := string(arena)
+	x := &index{
+		paths:   make(map[string]int32, len(entries)),
+		slots:   make([]any, len(entries)),
+		scalars: make([]scalar, len(entries)),
+		depths:  make([]uint16, len(entries)),
+	}
+	for i, e := range entries {
+		x.paths[all[e.start:e.end]] = int32(i)
+		x.slots[i] = e.value
+		x.scalars[i] = newScalar(e.value)
+		x.depths[i] = uint16(e.depth)
+	}
+	return x
+}
+
+// slot joins key on the stack and probes the index once. No key of an indexed meow
+// contains pathSep, so a lookup key containing it is undefined, yet joined it names a
+// deeper path: the depth of the slot found tells them apart.
+func (x *index) slot(key []string) (int32, bool) {
+	var buf [128]byte
+	p := buf[:0]
+	for i, k := range key {
+		if i > 0 {
+			p = append(p, pathSep...)
+		}
+		p = append(p, k...)
+	}
+	slot, ok := x.paths[string(p)]
+	return slot, ok && int(x.depths[slot]) == len(key)
+}
+
+func (x *index) lookup(key []string) (any, bool) {
+	slot, ok := x.slot(key)
+	if !ok {
+		return nil, false
+	}
+	return x.slots[slot], true
+}
@@ -0,0 +1,82 @@
+package meow
+
+import (
+	"reflect"
+	"strings"
+	"testing"
+)
+
+func TestIndex(t *testing.T) {
+
+	doc := `{"chess": {"a": {"b": {"c": "C", "d": [1, 2]}, "e": "E"}, "f.g": "F", "h": {"f\u001fg": 1}}}`
+	plain, err := LoadReader("chess", strings.NewReader(doc))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	meow, err := LoadReader("chess", strings.NewReader(`{"chess": {"a": {"b": {"c": "C", "d": [1, 2]}, "e": "E"}, "f.g": "F"}}`), WithIndex())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if meow.index == nil {
+		t.Fatalf("Error: no index built")
+	}
+	if plain.index != nil {
+		t.Errorf("Error: index built without option")
+	}
+
+	for _, key := range [][]string{{"a", "b", "c"}, {"a", "b", "d"}, {"a", "e"}, {"a", "b"}, {"a", "x"}, {"a", "e", "x"}, {"f", "g"}} {
+		if !reflect.DeepEqual(meow.Value(key...), plain.Value(key...)) {
+			t.Errorf("Error: found `%v` for %v", meow.Value(key...), key)
+		}
+		if meow.Exists(key...) != plain.Exists(key...) {
+			t.Errorf("Error: exists mismatch for %v", key)
+		}
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		_ = meow.ValueString("a", "b", "c")
+	})
+	if allocs != 0 {
+		t.Errorf("Error: %v allocations per lookup", allocs)
+	}
+
+	empty, err := LoadReader("chess", strings.NewReader(`{"chess": {"": {"": false, "0": true}, "0": {"0": 1}}}`), WithIndex())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	for _, key := range [][]string{{""}, {"", ""}, {"", "0"}, {"0"}, {"0", "0"}, {"", "", ""}} {
+		if found, expected := empty.Value(key...), descendKeys(empty.meow, key); !reflect.DeepEqual(found, expected) {
+			t.Errorf("Error: %q: found `%v`, expected `%v`", key, found, expected)
+		}
+	}
+
+	for _, key := range [][]string{{"a" + pathSep + "b", "c"}, {"a", "b" + pathSep + "c"}} {
+		if meow.Exists(key...) || meow.Value(key...) != nil || meow.ValueString(key...) != "" {
+			t.Errorf("Error: %q found through the joined path", key)
+		}
+		if _, ok := Lookup[string](meow, key...); ok {
+			t.Errorf("Error: %q looked up through the joined path", key)
+		}
+	}
+
+	sep, err := LoadReader("chess", strings.NewReader(doc), WithIndex())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if sep.index != nil || sep.ValueInt("h", "f"+pathSep+"g") != 1 {
+		t.Errorf("Error: index built over a key containing the separator")
+	}
+}
+
+// descendKeys walks the nested objects of m along key.
+func descendKeys(m map[string]any, key []string) any {
+	var v any = m
+	for _, k := range key {
+		obj, ok := v.(map[string]any)
+		if !ok {
+			return nil
+		}
+		v = obj[k]
+	}
+	return v
+}
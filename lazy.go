@@ -0,0 +1,118 @@
+package meow
+
+import (
+	"encoding/json"
+	"sync"
+)
+
+// lazyValue is a top-level value of a layer kept as raw JSON until it is first read, see
+// WithLazy. With a deep merge it stands for the values of several layers, from the highest
+// precedence down, merged on first read. Decoding happens once, whatever the number of
+// concurrent readers; the parts are never modified, so a merge may reuse them meanwhile.
+type lazyValue struct {
+	parts []any
+	o     *options
+	once  sync.Once
+	value any
+}
+
+// newLazy keeps a copy of raw, so the value does not pin the document or its mapping.
+func newLazy(raw []byte, o *options) *lazyValue {
+	return &lazyValue{parts: []any{json.RawMessage(append([]byte(nil), raw...))}, o: o}
+}
+
+// get returns the decoded value. The raw JSON was validated with the whole document, a
+// decoding error can only come from a part that is not valid on its own and yields nil.
+func (lv *lazyValue) get() any {
+	lv.once.Do(func() {
+		v := lv.part(0)
+		var lower []map[string]any
+		for i := 1; i < len(lv.parts); i++ {
+			p := lv.part(i)
+			lower = append(lower, map[string]any{"": p})
+			if _, ok := p.(map[string]any); !ok {
+				break
+			}
+		}
+		lv.value = mergeValue(lower, "", v)
+	})
+	return lv.value
+}
+
+func (lv *lazyValue) part(i int) any {
+	raw, ok := lv.parts[i].(json.RawMessage)
+	if !ok {
+		return lv.parts[i]
+	}
+	v, err := lv.o.decode(raw)
+	if err != nil {
+		return nil
+	}
+	return v
+}
+
+// over combines lv, the value of key k with the highest precedence, with the values of k in
+// the lower objects of a deep merge. The result is decoded and merged on first read only.
+func (lv *lazyValue) over(lower []map[string]any, k string) any {
+	var parts []any
+	for _, obj := range lower {
+		v, ok := obj[k]
+		if !ok {
+			continue
+		}
+		if parts == nil {
+			parts = append(parts, lv.parts...)
+		}
+		if l, ok := v.(*lazyValue); ok {
+			parts = append(parts, l.parts...)
+		} else {
+			parts = append(parts, v)
+		}
+	}
+	if parts == nil {
+		return lv
+	}
+	return &lazyValue{parts: parts, o: lv.o}
+}
+
+// resolve returns the decoded value of v when it is kept undecoded.
+func resolve(v any) any {
+	if lv, ok := v.(*lazyValue); ok {
+		return lv.get()
+	}
+	return v
+}
+
+// root returns the merged map with every top-level value decoded and the overrides of
+// the overlay applied.
+func (meow *Meow) root() map[string]any {
+	if x := meow.overlay; x != nil {
+		if x.root.set {
+			m, _ := x.root.value.(map[string]any)
+			return m
+		}
+		return meow.mergedAt(x.root)
+	}
+	return meow.baseRoot()
+}
+
+// baseRoot returns the merged map with every top-level value decoded. Without WithLazy it
+// is the merged map itself; otherwise the values are decoded on first call. With
+// WithArena, the map is built anew on every call.
+func (meow *Meow) baseRoot() map[string]any {
+	if meow.arena != nil {
+		m, _ := meow.arena.get(0).(map[string]any)
+		return m
+	}
+	if !meow.lazy {
+		return meow.meow
+	}
+	meow.full.Do(func() {
+		m := make(map[string]any, len(meow.meow))
+		for k, v := range meow.meow {
+			m[k] = resolve(v)
+		}
+		meow.all = m
+	})
+	return meow.all
+}
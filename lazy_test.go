@@ -0,0 +1,64 @@
+package meow
+
+import (
+	"bytes"
+	"reflect"
+	"sync"
+	"testing"
+)
+
+func TestLazy(t *testing.T) {
+
+	deep := `{
+		"base": {"meow-score": 1, "g1": {"a1": "base", "b1": "base", "n": {"x": 1, "y": 1}}, "only": {"z": [1]}, "s": {"a": 1}},
+		"mid": {"meow-score": 2, "g1": {"n": {"y": 2}}, "s": "scalar"},
+		"chess": {"g1": {"a1": "A"}, "s": {"b": 2}}
+	}`
+	for _, doc := range [][]byte{[]byte(body), []byte(deep), synthetic(500, 20)} {
+		appid := "chess"
+		if !bytes.Contains(doc, []byte(`"chess"`)) {
+			appid = "app"
+		}
+		for _, opts := range [][]Option{nil, {WithDeepMerge()}, {WithNumbers()}, {WithParallel(4)}, {WithDeepMerge(), WithParallel(4)}, {WithIndex()}} {
+			expected, err := LoadReader(appid, bytes.NewReader(doc), opts...)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			meow, err := LoadReader(appid, bytes.NewReader(doc), append(opts, WithLazy())...)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			for k, v := range expected.meow {
+				if !meow.Exists(k) || !reflect.DeepEqual(meow.Value(k), v) {
+					t.Errorf("Error: %d options: found\n%v\nexpected\n%v", len(opts), meow.Value(k), v)
+				}
+			}
+			if !reflect.DeepEqual(meow.Value(), expected.meow) {
+				t.Errorf("Error: %d options: results differ", len(opts))
+			}
+		}
+	}
+
+	// Concurrent first reads decode each value once.
+	meow, err := LoadReader("app", bytes.NewReader(synthetic(200, 10)), WithLazy(), WithDeepMerge())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	var wg sync.WaitGroup
+	values := make([]any, 8)
+	for i := range values {
+		wg.Add(1)
+		go func(i int) {
+			defer wg.Done()
+			values[i] = meow.Value("g9_0")
+			meow.ValueInt("g9_0", "k9_1")
+			meow.Value()
+		}(i)
+	}
+	wg.Wait()
+	for _, v := range values {
+		if reflect.ValueOf(v).Pointer() != reflect.ValueOf(values[0]).Pointer() {
+			t.Errorf("Error: value decoded several times")
+		}
+	}
+}
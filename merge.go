@@ -0,0 +1,56 @@
+package meow
+
+// deepMerge merges objects given from the highest precedence down. Nested objects are
+// merged recursively, any other value hides the values of the lower objects. An object
+// defined by a single layer is returned as is, so untouched subtrees are shared by all
+// the meows built from the layers and memory grows with the overrides only.
+func deepMerge(objs []map[string]any) map[string]any {
+	switch len(objs) {
+	case 0:
+		return map[string]any{}
+	case 1:
+		return objs[0]
+	}
+	m := make(map[string]any, len(objs[0]))
+	for i, obj := range objs {
+		for k, v := range obj {
+			if _, ok := m[k]; ok {
+				continue
+			}
+			m[k] = mergeValue(objs[i+1:], k, v)
+		}
+	}
+	return m
+}
+
+// mergeValue merges v, the value of key k with the highest precedence, with the values of
+// k in the lower objects. Merging stops at the first lower value that is not an object.
+// A value kept undecoded is merged on first read, see lazyValue.
+func mergeValue(lower []map[string]any, k string, v any) any {
+	if lv, ok := v.(*lazyValue); ok {
+		return lv.over(lower, k)
+	}
+	sub, ok := v.(map[string]any)
+	if !ok {
+		return v
+	}
+	var subs []map[string]any
+	for _, obj := range lower {
+		lv, ok := obj[k]
+		if !ok {
+			continue
+		}
+		lsub, ok := lv.(map[string]any)
+		if !ok {
+			break
+		}
+		if subs == nil {
+			subs = append(subs, sub)
+		}
+		subs = append(subs, lsub)
+	}
+	if subs == nil {
+		return sub
+	}
+	return deepMerge(subs)
+}
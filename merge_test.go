@@ -0,0 +1,44 @@
+package meow
+
+import (
+	"reflect"
+	"strings"
+	"testing"
+)
+
+func TestDeepMerge(t *testing.T) {
+
+	doc := `{
+		"base": {"meow-score": 1, "g1": {"a1": "base", "b1": "base", "n": {"x": 1, "y": 1}}, "only": {"z": [1]}, "s": {"a": 1}},
+		"mid": {"meow-score": 2, "g1": {"n": {"y": 2}}, "s": "scalar"},
+		"chess": {"g1": {"a1": "A"}, "s": {"b": 2}}
+	}`
+	meow, err := LoadReader("chess", strings.NewReader(doc), WithDeepMerge())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	expected := map[string]any{
+		"meow-score": 2.0,
+		"g1":         map[string]any{"a1": "A", "b1": "base", "n": map[string]any{"x": 1.0, "y": 2.0}},
+		"only":       map[string]any{"z": []any{1.0}},
+		"s":          map[string]any{"b": 2.0},
+	}
+	if !reflect.DeepEqual(meow.meow, expected) {
+		t.Errorf("Error: found\n%v\nexpected\n%v", meow.meow, expected)
+	}
+
+	shallow, err := LoadReader("chess", strings.NewReader(doc))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if shallow.ValueString("g1", "b1") != "" {
+		t.Errorf("Error: nested objects merged without the option")
+	}
+
+	// A subtree defined by a single layer is shared and not copied.
+	objs := []map[string]any{{"a": map[string]any{"b": 1}}, {"c": 1}}
+	merged := deepMerge(objs)
+	if reflect.ValueOf(merged["a"]).Pointer() != reflect.ValueOf(objs[0]["a"]).Pointer() {
+		t.Errorf("Error: untouched subtree copied")
+	}
+}
@@ -0,0 +1,299 @@
+package meow
+
+import (
+	"context"
+	"encoding/json"
+	"fmt"
+	"io"
+	"math/rand"
+	"runtime"
+	"runtime/trace"
+	"sort"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// Metrics collects the timings of the loads and the reads of the meows built with
+// WithMetrics. It implements expvar.Var, so it can be published with expvar.Publish, and
+// writes the Prometheus text format with WritePrometheus.
+type Metrics struct {
+	sample uint32
+
+	mu    sync.Mutex
+	loads uint64
+	total LoadStats
+	last  LoadStats
+
+	counters sync.Mutex
+	reads    atomic.Pointer[map[string]*readCounter] // encoded key sequence, see viewKey
+}
+
+// LoadStats describes a load. Read is the time spent reading the input, Parse the time
+// spent decoding the layers, Sort the time spent ordering them and Merge the time spent
+// merging them and building the index. Allocs and AllocBytes count the heap allocations
+// of the whole process during the load.
+type LoadStats struct {
+	Read       time.Duration `json:"read"`
+	Parse      time.Duration `json:"parse"`
+	Sort       time.Duration `json:"sort"`
+	Merge      time.Duration `json:"merge"`
+	Bytes      int64         `json:"bytes"`
+	Keys       int           `json:"keys"`
+	Allocs     uint64        `json:"allocs"`
+	AllocBytes uint64        `json:"alloc_bytes"`
+}
+
+// KeyReads is the estimated number of reads of a sequence of keys.
+type KeyReads struct {
+	Key   []string `json:"key"`
+	Reads uint64   `json:"reads"`
+}
+
+// NewMetrics returns metrics counting one read out of sample with Value and Exists, every
+// read when sample is not positive. A sampled read counts for sample reads.
+func NewMetrics(sample int) *Metrics {
+	if sample <= 0 {
+		sample = 1
+	}
+	return &Metrics{sample: uint32(sample)}
+}
+
+// readShards is the number of counters of a key, so that concurrent readers of a hot key
+// rarely update the same cache line.
+const readShards = 8
+
+type readCounter struct {
+	shards [readShards]struct {
+		n atomic.Uint64
+		_ [56]byte
+	}
+	key []string
+}
+
+// read counts a read of key. The counters are created on first read and updated without
+// locking; readers look them up in an immutable map, by the encoding of key built without
+// allocating.
+func (m *Metrics) read(key []string) {
+	r := uint32(0)
+	if m.sample > 1 || len(key) > 0 {
+		r = rand.Uint32()
+	}
+	if m.sample > 1 && r%m.sample != 0 {
+		return
+	}
+	var buf [128]byte
+	p := viewKey(buf[:0], 0, key)
+	var c *readCounter
+	if reads := m.reads.Load(); reads != nil {
+		c = (*reads)[string(p)]
+	}
+	if c == nil {
+		c = m.counter(string(p), key)
+	}
+	c.shards[r/m.sample%readShards].n.Add(uint64(m.sample))
+}
+
+// counter returns the counter of key, encoded as p, and publishes a copy of the map of
+// counters with a new one if there is none.
+func (m *Metrics) counter(p string, key []string) *readCounter {
+	m.counters.Lock()
+	defer m.counters.Unlock()
+	old := m.reads.Load()
+	if old != nil {
+		if c, ok := (*old)[p]; ok {
+			return c
+		}
+	}
+	reads := make(map[string]*readCounter, 1)
+	if old != nil {
+		reads = make(map[string]*readCounter, len(*old)+1)
+		for k, c := range *old {
+			reads[k] = c
+		}
+	}
+	c := &readCounter{key: append([]string(nil), key...)}
+	reads[p] = c
+	m.reads.Store(&reads)
+	return c
+}
+
+// Reads returns the estimated number of reads of every sequence of keys read so far, the
+// most read first.
+func (m *Metrics) Reads() []KeyReads {
+	var reads []KeyReads
+	if counters := m.reads.Load(); counters != nil {
+		for _, c := range *counters {
+			n := uint64(0)
+			for i := range c.shards {
+				n += c.shards[i].n.Load()
+			}
+			reads = append(reads, KeyReads{c.key, n})
+		}
+	}
+	sort.Slice(reads, func(i, j int) bool {
+		if reads[i].Reads != reads[j].Reads {
+			return reads[i].Reads > reads[j].Reads
+		}
+		a, b := reads[i].Key, reads[j].Key
+		for k := 0; k < len(a) && k < len(b); k++ {
+			if a[k] != b[k] {
+				return a[k] < b[k]
+			}
+		}
+		return len(a) < len(b)
+	})
+	return reads
+}
+
+// LastLoad returns the statistics of the last load.
+func (m *Metrics) LastLoad() LoadStats {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	return m.last
+}
+
+// Loads returns the number of loads and the sum of their statistics.
+func (m *Metrics) Loads() (uint64, LoadStats) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	return m.loads, m.total
+}
+
+func (m *Metrics) record(s LoadStats) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	m.loads++
+	m.last = s
+	m.total.Read += s.Read
+	m.total.Parse += s.Parse
+	m.total.Sort += s.Sort
+	m.total.Merge += s.Merge
+	m.total.Bytes += s.Bytes
+	m.total.Keys += s.Keys
+	m.total.Allocs += s.Allocs
+	m.total.AllocBytes += s.AllocBytes
+}
+
+// String returns the metrics as a JSON object, see expvar.Var.
+func (m *Metrics) String() string {
+	loads, total := m.Loads()
+	data, _ := json.Marshal(struct {
+		Loads uint64     `json:"loads"`
+		Total LoadStats  `json:"total"`
+		Last  LoadStats  `json:"last"`
+		Reads []KeyReads `json:"reads"`
+	}{loads, total, m.LastLoad(), m.Reads()})
+	return string(data)
+}
+
+// WritePrometheus writes the metrics in the Prometheus text exposition format. A sequence of
+// keys is labelled with its keys joined with ".", in which dots and backslashes are escaped
+// with a backslash.
+func (m *Metrics) WritePrometheus(w io.Writer) error {
+	loads, total := m.Loads()
+	var b strings.Builder
+	fmt.Fprintf(&b, "# TYPE meow_loads_total counter\nmeow_loads_total %d\n", loads)
+	b.WriteString("# TYPE meow_load_seconds_total counter\n")
+	for _, p := range []struct {
+		phase string
+		d     time.Duration
+	}{{"read", total.Read}, {"parse", total.Parse}, {"sort", total.Sort}, {"merge", total.Merge}} {
+		fmt.Fprintf(&b, "meow_load_seconds_total{phase=%q} %g\n", p.phase, p.d.Seconds())
+	}
+	fmt.Fprintf(&b, "# TYPE meow_load_bytes_total counter\nmeow_load_bytes_total %d\n", total.Bytes)
+	fmt.Fprintf(&b, "# TYPE meow_load_allocs_total counter\nmeow_load_allocs_total %d\n", total.Allocs)
+	fmt.Fprintf(&b, "# TYPE meow_load_alloc_bytes_total counter\nmeow_load_alloc_bytes_total %d\n", total.AllocBytes)
+	fmt.Fprintf(&b, "# TYPE meow_keys gauge\nmeow_keys %d\n", m.LastLoad().Keys)
+	b.WriteString("# TYPE meow_key_reads_total counter\n")
+	for _, r := range m.Reads() {
+		fmt.Fprintf(&b, "meow_key_reads_total{key=%s} %d\n", promLabel(keyLabel(r.Key)), r.Reads)
+	}
+	_, err := io.WriteString(w, b.String())
+	return err
+}
+
+// keyLabel joins a sequence of keys with ".", escaping the dots and backslashes of keys so
+// that distinct sequences get distinct labels.
+func keyLabel(key []string) string {
+	var b strings.Builder
+	for i, k := range key {
+		if i > 0 {
+			b.WriteByte('.')
+		}
+		keyEscaper.WriteString(&b, k)
+	}
+	return b.String()
+}
+
+var keyEscaper = strings.NewReplacer(`\`, `\\`, `.`, `\.`)
+
+// promLabel quotes a label value, escaping backslashes, quotes and newlines.
+func promLabel(s string) string {
+	return `"` + strings.NewReplacer(`\`, `\\`, `"`, `\"`, "\n", `\n`).Replace(s) + `"`
+}
+
+// loadTimer measures the phases of a load for WithMetrics and WithProfile.
+type loadTimer struct {
+	metrics *Metrics
+	stats   LoadStats
+	start   time.Time
+	mem     runtime.MemStats
+
+	profile func(*LoadReport)
+	ctx     context.Context
+	task    *trace.Task
+	layers  []LayerReport
+}
+
+// startLoad starts measuring a load. Reading the allocation counters briefly stops the
+// world, a cost only paid with WithMetrics and WithProfile.
+func startLoad(o *options) *loadTimer {
+	t := &loadTimer{metrics: o.metrics, profile: o.profile}
+	if t.profile != nil {
+		t.ctx, t.task = trace.NewTask(context.Background(), "meow.Load")
+	}
+	runtime.ReadMemStats(&t.mem)
+	t.start = time.Now()
+	return t
+}
+
+// parsed ends the read, parse and sort phases.
+func (t *loadTimer) parsed() {
+	t.stats.Parse = time.Since(t.start) - t.stats.Read - t.stats.Sort
+	t.start = time.Now()
+}
+
+// done ends the merge phase and records the load.
+func (t *loadTimer) done(meow *Meow) {
+	t.stats.Merge = time.Since(t.start)
+	t.stats.Keys = len(meow.meow)
+	if meow.arena != nil {
+		t.stats.Keys = meow.arena.len()
+	}
+	objects, bytes := t.mem.Mallocs, t.mem.TotalAlloc
+	runtime.ReadMemStats(&t.mem)
+	t.stats.Allocs = t.mem.Mallocs - objects
+	t.stats.AllocBytes = t.mem.TotalAlloc - bytes
+	if t.metrics != nil {
+		t.metrics.record(t.stats)
+	}
+	if t.profile != nil {
+		t.report()
+	}
+}
+
+// timedReader adds the time spent in its reader to the read phase of a load.
+type timedReader struct {
+	r io.Reader
+	t *loadTimer
+}
+
+func (r *timedReader) Read(p []byte) (int, error) {
+	start := time.Now()
+	n, err := r.r.Read(p)
+	r.t.stats.Read += time.Since(start)
+	r.t.stats.Bytes += int64(n)
+	return n, err
+}
@@ -0,0 +1,97 @@
+package meow
+
+import (
+	"bytes"
+	"encoding/json"
+	"reflect"
+	"strings"
+	"sync"
+	"testing"
+)
+
+func TestMetrics(t *testing.T) {
+
+	m := NewMetrics(0)
+	for _, opts := range [][]Option{nil, {WithParallel(2)}, {WithDecoder(FastDecoder{})}} {
+		meow, err := LoadReader("chess", strings.NewReader(body), append(opts, WithMetrics(m))...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		last := m.LastLoad()
+		if last.Bytes != int64(len(body)) || last.Keys != len(meow.meow) || last.Parse <= 0 || last.Merge <= 0 || last.Allocs == 0 {
+			t.Errorf("Error: %d options: found %+v", len(opts), last)
+		}
+	}
+	if loads, total := m.Loads(); loads != 3 || total.Bytes != 3*int64(len(body)) {
+		t.Errorf("Error: found %d loads, %+v", loads, total)
+	}
+
+	meow, err := LoadReader("chess", strings.NewReader(body), WithMetrics(m))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	var wg sync.WaitGroup
+	for i := 0; i < 4; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for j := 0; j < 100; j++ {
+				meow.ValueString("g1", "a1")
+				meow.Exists("key-test1")
+			}
+		}()
+	}
+	wg.Wait()
+	meow.Value()
+	expected := []KeyReads{{[]string{"g1", "a1"}, 400}, {[]string{"key-test1"}, 400}, {nil, 1}}
+	if found := m.Reads(); !reflect.DeepEqual(found, expected) {
+		t.Errorf("Error: found %v", found)
+	}
+
+	var v map[string]any
+	if err := json.Unmarshal([]byte(m.String()), &v); err != nil || v["loads"] != 4.0 {
+		t.Errorf("Error: found %s: %v", m.String(), err)
+	}
+	var b bytes.Buffer
+	if err := m.WritePrometheus(&b); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	for _, line := range []string{`meow_loads_total 4`, `meow_load_seconds_total{phase="parse"}`, `meow_key_reads_total{key="g1.a1"} 400`} {
+		if !strings.Contains(b.String(), line) {
+			t.Errorf("Error: `%s` not found in\n%s", line, b.String())
+		}
+	}
+
+	// Keys containing dots are told apart from sequences of keys.
+	dotted := NewMetrics(0)
+	dotted.read([]string{"a.b"})
+	dotted.read([]string{"a", "b"})
+	dotted.read([]string{"a", "b"})
+	expected = []KeyReads{{[]string{"a", "b"}, 2}, {[]string{"a.b"}, 1}}
+	if found := dotted.Reads(); !reflect.DeepEqual(found, expected) {
+		t.Errorf("Error: found %v", found)
+	}
+	b.Reset()
+	dotted.WritePrometheus(&b)
+	for _, line := range []string{`meow_key_reads_total{key="a.b"} 2`, `meow_key_reads_total{key="a\\.b"} 1`} {
+		if !strings.Contains(b.String(), line) {
+			t.Errorf("Error: `%s` not found in\n%s", line, b.String())
+		}
+	}
+	if n := testing.AllocsPerRun(100, func() { dotted.read([]string{"a", "b"}) }); n != 0 {
+		t.Errorf("Error: %v allocations per read", n)
+	}
+
+	// Sampled reads are estimates.
+	sampled := NewMetrics(4)
+	meow, err = LoadReader("chess", strings.NewReader(body), WithMetrics(sampled))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	for i := 0; i < 4000; i++ {
+		meow.ValueString("key-test1")
+	}
+	if n := sampled.Reads()[0].Reads; n%4 != 0 || n < 3000 || n > 5000 {
+		t.Errorf("Error: found %d reads", n)
+	}
+}
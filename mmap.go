@@ -0,0 +1,51 @@
+package meow
+
+import (
+	"fmt"
+	"time"
+)
+
+// LoadMapped loads the meow for an application appid from a given file like LoadFile, but
+// maps the file into memory and decodes the layers directly from the mapped pages instead
+// of copying the file through a reader. The mapping is released once the meow is built:
+// the decoded values never reference it.
+func LoadMapped(appid string, meowFile string, opts ...Option) (*Meow, error) {
+	if appid == "" {
+		return nil, fmt.Errorf("meow identification is empty")
+	}
+	if meowFile == "" {
+		return nil, fmt.Errorf("no meow file specified")
+	}
+
+	o := newOptions(opts)
+	if o.metrics != nil || o.profile != nil {
+		o.timer = startLoad(o)
+	}
+	data, release, err := mapFile(meowFile)
+	if err != nil {
+		return nil, fmt.Errorf("error at opening meow file `%s`: %s", meowFile, err)
+	}
+	defer release()
+	if o.timer != nil {
+		o.timer.stats.Read = time.Since(o.timer.start)
+		o.timer.stats.Bytes = int64(len(data))
+	}
+
+	mews, err := readSpans(appid, data, o)
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow file `%s`: %s", meowFile, err)
+	}
+	if o.timer != nil {
+		o.timer.parsed()
+	}
+	var meow *Meow
+	o.timer.phase("build", "", func() { meow, err = newMeow(appid, o.timer.merge(mews, o.deep), o) })
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow file `%s`: %s", meowFile, err)
+	}
+	meow.meowFile = meowFile
+	if o.timer != nil {
+		o.timer.done(meow)
+	}
+	return meow, nil
+}
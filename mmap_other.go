@@ -0,0 +1,11 @@
+//go:build !unix
+
+package meow
+
+import "os"
+
+// mapFile reads a file into memory on platforms without mmap.
+func mapFile(name string) ([]byte, func(), error) {
+	data, err := os.ReadFile(name)
+	return data, func() {}, err
+}
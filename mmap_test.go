@@ -0,0 +1,40 @@
+package meow
+
+import (
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+)
+
+func TestLoadMapped(t *testing.T) {
+
+	dir := t.TempDir()
+	meowFile := filepath.Join(dir, "meow.json")
+	doc := strings.Replace(body, `"general2": {`, `"skipped": {"meow-score": "x", "a": [1, {"b": 2}]}, "general2": {`, 1)
+	if err := os.WriteFile(meowFile, []byte(doc), 0o600); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	meow, err := LoadMapped("chess", meowFile)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	expected, err := LoadFile("chess", meowFile)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if !reflect.DeepEqual(meow.meow, expected.meow) {
+		t.Errorf("Error: found\n%v\nexpected\n%v", meow.meow, expected.meow)
+	}
+
+	for _, doc := range []string{"", `{"chess": 1}`, `{"other": {}}`, `{"chess": {"a": }}`} {
+		os.WriteFile(meowFile, []byte(doc), 0o600)
+		if _, err := LoadMapped("chess", meowFile); err == nil {
+			t.Errorf("Error: no error for `%s`", doc)
+		}
+	}
+	if _, err := LoadMapped("chess", filepath.Join(dir, "none.json")); err == nil {
+		t.Errorf("Error: no error for a missing file")
+	}
+}
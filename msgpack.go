@@ -0,0 +1,290 @@
+package meow
+
+import (
+	"fmt"
+	"math"
+)
+
+// MessagePack decodes meow documents encoded with MessagePack, see WithDecoder. Documents
+// starting with a MessagePack map are detected and decoded with it without WithDecoder.
+// Maps must have string keys; binary values decode to strings, integers and floats to
+// float64 or json.Number. Extension types are rejected.
+type MessagePack struct{}
+
+// Valid reports whether data is a single valid MessagePack value. It does not allocate.
+func (MessagePack) Valid(data []byte) bool {
+	r := msgpackReader{data: data}
+	return r.skip(0) == nil && r.i == len(data)
+}
+
+// Decode decodes data, a single MessagePack value.
+func (MessagePack) Decode(data []byte, numbers bool) (any, error) {
+	r := msgpackReader{data: data, numbers: numbers}
+	v, err := r.value(0)
+	if err == nil && r.i != len(data) {
+		err = fmt.Errorf("invalid MessagePack: trailing data")
+	}
+	return v, err
+}
+
+func (MessagePack) split(data []byte) ([]span, error) {
+	r := msgpackReader{data: data}
+	n, err := r.mapHeader()
+	if err != nil {
+		return nil, err
+	}
+	if n > uint64(len(data)-r.i)/2 {
+		return nil, r.errorf("unexpected end")
+	}
+	spans := make([]span, 0, n)
+	for ; n > 0; n-- {
+		key, err := r.key()
+		if err != nil {
+			return nil, err
+		}
+		start := r.i
+		if err := r.skip(1); err != nil {
+			return nil, err
+		}
+		spans = append(spans, span{key, start, r.i})
+	}
+	if r.i != len(data) {
+		return nil, fmt.Errorf("invalid MessagePack: trailing data")
+	}
+	return spans, nil
+}
+
+func (MessagePack) object(c byte) bool {
+	return c >= 0x80 && c <= 0x8f || c == 0xde || c == 0xdf
+}
+
+// msgpackReader reads MessagePack values from data at offset i.
+type msgpackReader struct {
+	data    []byte
+	i       int
+	numbers bool
+}
+
+func (r *msgpackReader) errorf(format string, args ...any) error {
+	return fmt.Errorf("invalid MessagePack at offset %d: %s", r.i, fmt.Sprintf(format, args...))
+}
+
+// next returns the n bytes at the offset and moves past them.
+func (r *msgpackReader) next(n uint64) ([]byte, error) {
+	if n > uint64(len(r.data)-r.i) {
+		return nil, r.errorf("unexpected end")
+	}
+	b := r.data[r.i : r.i+int(n)]
+	r.i += int(n)
+	return b, nil
+}
+
+// uint reads a big-endian unsigned integer of n bytes.
+func (r *msgpackReader) uint(n uint64) (uint64, error) {
+	b, err := r.next(n)
+	if err != nil {
+		return 0, err
+	}
+	var u uint64
+	for _, c := range b {
+		u = u<<8 | uint64(c)
+	}
+	return u, nil
+}
+
+// header reads the type byte of a value. For strings, binaries, arrays and maps it returns
+// the kind of the value, 's', 'a' or 'm', and its length; extensions are rejected.
+func (r *msgpackReader) header() (byte, byte, uint64, error) {
+	if r.i == len(r.data) {
+		return 0, 0, 0, r.errorf("unexpected end")
+	}
+	c := r.data[r.i]
+	r.i++
+	var n uint64
+	var err error
+	switch {
+	case c >= 0x80 && c <= 0x8f:
+		return c, 'm', uint64(c & 0x0f), nil
+	case c >= 0x90 && c <= 0x9f:
+		return c, 'a', uint64(c & 0x0f), nil
+	case c >= 0xa0 && c <= 0xbf:
+		return c, 's', uint64(c & 0x1f), nil
+	case c == 0xc4 || c == 0xd9:
+		n, err = r.uint(1)
+		return c, 's', n, err
+	case c == 0xc5 || c == 0xda:
+		n, err = r.uint(2)
+		return c, 's', n, err
+	case c == 0xc6 || c == 0xdb:
+		n, err = r.uint(4)
+		return c, 's', n, err
+	case c == 0xdc:
+		n, err = r.uint(2)
+		return c, 'a', n, err
+	case c == 0xdd:
+		n, err = r.uint(4)
+		return c, 'a', n, err
+	case c == 0xde:
+		n, err = r.uint(2)
+		return c, 'm', n, err
+	case c == 0xdf:
+		n, err = r.uint(4)
+		return c, 'm', n, err
+	case c == 0xc1, c >= 0xc7 && c <= 0xc9, c >= 0xd4 && c <= 0xd8:
+		r.i--
+		return 0, 0, 0, r.errorf("unsupported type 0x%02x", c)
+	}
+	return c, 0, 0, nil
+}
+
+func (r *msgpackReader) mapHeader() (uint64, error) {
+	_, kind, n, err := r.header()
+	if err == nil && kind != 'm' {
+		err = fmt.Errorf("does not contain a valid MessagePack map")
+	}
+	return n, err
+}
+
+func (r *msgpackReader) key() (string, error) {
+	b, err := r.keyBytes()
+	return string(b), err
+}
+
+func (r *msgpackReader) keyBytes() ([]byte, error) {
+	_, kind, n, err := r.header()
+	if err != nil {
+		return nil, err
+	}
+	if kind != 's' {
+		return nil, r.errorf("map key is not a string")
+	}
+	return r.next(n)
+}
+
+// skip moves past a value without decoding it.
+func (r *msgpackReader) skip(depth int) error {
+	if depth > maxDepth {
+		return r.errorf("exceeded max depth")
+	}
+	c, kind, n, err := r.header()
+	if err != nil {
+		return err
+	}
+	switch kind {
+	case 's':
+		_, err = r.next(n)
+		return err
+	case 'a', 'm':
+		for ; n > 0; n-- {
+			if kind == 'm' {
+				if _, err := r.keyBytes(); err != nil {
+					return err
+				}
+			}
+			if err := r.skip(depth + 1); err != nil {
+				return err
+			}
+		}
+		return nil
+	}
+	u, err := r.uint(msgpackSize(c))
+	if err == nil && (c == 0xca || c == 0xcb) {
+		_, err = r.float(c, u)
+	}
+	return err
+}
+
+// msgpackSize returns the size of the payload of a scalar type byte.
+func msgpackSize(c byte) uint64 {
+	switch c {
+	case 0xcc, 0xd0:
+		return 1
+	case 0xcd, 0xd1:
+		return 2
+	case 0xca, 0xce, 0xd2:
+		return 4
+	case 0xcb, 0xcf, 0xd3:
+		return 8
+	}
+	return 0
+}
+
+func (r *msgpackReader) value(depth int) (any, error) {
+	if depth > maxDepth {
+		return nil, r.errorf("exceeded max depth")
+	}
+	c, kind, n, err := r.header()
+	if err != nil {
+		return nil, err
+	}
+	switch kind {
+	case 's':
+		b, err := r.next(n)
+		return string(b), err
+	case 'a':
+		if n > uint64(len(r.data)-r.i) {
+			return nil, r.errorf("unexpected end")
+		}
+		a := make([]any, n)
+		for i := range a {
+			if a[i], err = r.value(depth + 1); err != nil {
+				return nil, err
+			}
+		}
+		return a, nil
+	case 'm':
+		if n > uint64(len(r.data)-r.i)/2 {
+			return nil, r.errorf("unexpected end")
+		}
+		m := make(map[string]any, n)
+		for ; n > 0; n-- {
+			k, err := r.key()
+			if err != nil {
+				return nil, err
+			}
+			if m[k], err = r.value(depth + 1); err != nil {
+				return nil, err
+			}
+		}
+		return m, nil
+	}
+	switch {
+	case c <= 0x7f:
+		return number(int64(c), r.numbers), nil
+	case c >= 0xe0:
+		return number(int64(int8(c)), r.numbers), nil
+	case c == 0xc0:
+		return nil, nil
+	case c == 0xc2 || c == 0xc3:
+		return c == 0xc3, nil
+	}
+	size := msgpackSize(c)
+	u, err := r.uint(size)
+	if err != nil {
+		return nil, err
+	}
+	switch c {
+	case 0xca, 0xcb:
+		f, err := r.float(c, u)
+		if err != nil {
+			return nil, err
+		}
+		return float(f, r.numbers), nil
+	case 0xcc, 0xcd, 0xce, 0xcf:
+		return unsigned(u, r.numbers), nil
+	}
+	shift := 64 - 8*size
+	return number(int64(u<<shift)>>shift, r.numbers), nil
+}
+
+// float converts the bits u of a float of type c and rejects values that are not finite.
+func (r *msgpackReader) float(c byte, u uint64) (float64, error) {
+	f := math.Float64frombits(u)
+	if c == 0xca {
+		f = float64(math.Float32frombits(uint32(u)))
+	}
+	if math.IsNaN(f) || math.IsInf(f, 0) {
+		return 0, r.errorf("number is not finite")
+	}
+	return f, nil
+}
@@ -1,4 +1,4 @@
-package tubu
+package meow
 
 import (
 	"bufio"
@@ -8,19 +8,40 @@ import (
 	"io"
 	"os"
 	"sort"
+	"strconv"
+	"sync"
+	"time"
 )
 
 // meow holds the meow. This is set of configuration settings for use within an application.
 // The meow can be loaded from a file or, more generally, from an io.Reader.
 
 type Meow struct {
-	appid        string
+	appid    string
 	meowFile string
 	meow     map[string]any
+	index    *index
+	views    *views
+	lazy     bool
+	deep     bool
+	numbers  bool
+	full     sync.Once
+	all      map[string]any
+
+	generation uint64
+	digested   sync.Once
+	digests    *digest
+	metrics    *Metrics
+	arena      *arena
+	sorted     sync.Map
+	overlay    *overlay
+	overlaid   sync.Map
+	schema     *Schema
+	typed      map[string]any
 }
 
 // LoadEnv loads the meow from a file pointed to by an environment variable.
-func LoadEnv(appid string, env string) (*meow, error) {
+func LoadEnv(appid string, env string, opts ...Option) (*Meow, error) {
 	if env == "" {
 		return nil, fmt.Errorf("environment variable for meow is empty")
 	}
@@ -28,11 +49,11 @@ func LoadEnv(appid string, env string) (*meow, error) {
 	if !found {
 		return nil, fmt.Errorf("environment variable `%s` for meow does not exist", env)
 	}
-	return LoadFile(appid, tubuFile)
+	return LoadFile(appid, meowFile, opts...)
 }
 
 // LoadFile loads the meow for an application appid from a given file.
-func LoadFile(appid string, tubuFile string) (*Meow, error) {
+func LoadFile(appid string, meowFile string, opts ...Option) (*Meow, error) {
 	if appid == "" {
 		return nil, fmt.Errorf("meow identification is empty")
 	}
@@ -40,162 +61,567 @@ func LoadFile(appid string, tubuFile string) (*Meow, error) {
 		return nil, fmt.Errorf("no meow file specified")
 	}
 
-	r, err := os.Open(tubuFile)
+	r, err := os.Open(meowFile)
 	if err != nil {
 		return nil, fmt.Errorf("error at opening meow file `%s`: %s", meowFile, err)
 	}
+	defer r.Close()
 
-	meow, err := LoadReader(appid, bufio.NewReader(r))
+	meow, err := LoadReader(appid, bufio.NewReader(r), opts...)
 
 	if err != nil {
 		return nil, fmt.Errorf("error at handling meow file `%s`: %s", meowFile, err)
 	}
 
-	meow.MeowFile = meowFile
+	meow.meowFile = meowFile
 	return meow, nil
 }
 
-// LoadReader loads the meow for an application appid from a given io.Reader
-func LoadReader(appid string, reader io.Reader) (*Meow, error) {
-	buf := new(bytes.Buffer)
-	size, err := buf.ReadFrom(reader)
+// layer is a top-level object of the meow document that takes part in the merge.
+type layer struct {
+	name  string
+	score int
+	value map[string]any
+	// report describes the decoding of the layer with WithProfile.
+	report *LayerReport
+}
+
+// skipValue consumes a JSON value without materializing it.
+type skipValue struct{}
+
+func (skipValue) UnmarshalJSON([]byte) error { return nil }
+
+// LoadReader loads the meow for an application appid from a given io.Reader.
+// The document is read as a stream of JSON tokens: only the layers carrying a `meow-score`
+// and the appid layer are decoded, every other top-level value is skipped. With
+// WithParallel the document is read into memory first and its layers decoded concurrently,
+// with WithDecoder it is read into memory and decoded by the given decoder. Documents in
+// MessagePack or CBOR are detected from their first byte, read into memory and decoded with
+// MessagePack or CBOR, see Decoder.
+func LoadReader(appid string, reader io.Reader, opts ...Option) (*Meow, error) {
+	o := newOptions(opts)
+	if o.metrics != nil || o.profile != nil {
+		o.timer = startLoad(o)
+		reader = &timedReader{r: reader, t: o.timer}
+	}
+	binary := false
+	if o.decoder == nil {
+		br, ok := reader.(*bufio.Reader)
+		if !ok {
+			br = bufio.NewReader(reader)
+		}
+		reader = br
+		c, err := br.Peek(1)
+		binary = err == nil && detectFormat(c[0]) != nil
+	}
+	var mews []layer
+	var err error
+	if o.workers > 1 || o.decoder != nil || binary {
+		var data []byte
+		o.timer.phase("read", "", func() { data, err = io.ReadAll(reader) })
+		if err != nil {
+			return nil, err
+		}
+		mews, err = readSpans(appid, data, o)
+	} else {
+		mews, err = readLayers(appid, reader, o)
+	}
+	if err != nil {
+		return nil, err
+	}
+	if o.timer != nil {
+		o.timer.parsed()
+	}
+	var meow *Meow
+	o.timer.phase("build", "", func() { meow, err = newMeow(appid, o.timer.merge(mews, o.deep), o) })
 	if err != nil {
 		return nil, err
 	}
+	if o.timer != nil {
+		o.timer.done(meow)
+	}
+	return meow, nil
+}
 
-	if size < 2 {
+// readLayers decodes the layers of a document and returns them in merge order.
+func readLayers(appid string, reader io.Reader, o *options) ([]layer, error) {
+	dec := json.NewDecoder(reader)
+	if o.numbers {
+		dec.UseNumber()
+	}
+	tok, err := dec.Token()
+	if err == io.EOF {
 		return nil, fmt.Errorf("empty meow")
 	}
-	r := make(map[string]any)
-	err = json.Unmarshal(buf.Bytes(), &r)
-
 	if err != nil {
 		return nil, fmt.Errorf("does not contain a valid JSON object: %s", err)
 	}
+	if d, ok := tok.(json.Delim); !ok || d != '{' {
+		return nil, fmt.Errorf("does not contain a valid JSON object")
+	}
+
+	set := layerSet{appid: appid, timer: o.timer}
+	for dec.More() {
+		tok, err := dec.Token()
+		if err != nil {
+			return nil, fmt.Errorf("does not contain a valid JSON object: %s", err)
+		}
+		key := tok.(string)
+		offset := dec.InputOffset()
+		mw, scored, err := o.timer.parse(key, func() (layer, bool, error) { return decodeLayer(dec, key == appid, o) })
+		if err != nil {
+			return nil, fmt.Errorf("does not contain a valid JSON object: %s", err)
+		}
+		if mw.report != nil {
+			mw.report.Bytes = dec.InputOffset() - offset
+		}
+		if err := set.add(key, mw, scored); err != nil {
+			return nil, err
+		}
+	}
+	if _, err := dec.Token(); err != nil {
+		return nil, fmt.Errorf("does not contain a valid JSON object: %s", err)
+	}
+	if _, err := dec.Token(); err != io.EOF {
+		return nil, fmt.Errorf("does not contain a valid JSON object: trailing data")
+	}
+	return set.ordered()
+}
 
-	_, ok := r[appid]
+// layerSet collects the top-level values of a document that take part in the merge. As with
+// json.Unmarshal, a later value of a name replaces the earlier one, layer or not.
+type layerSet struct {
+	appid  string
+	app    map[string]any
+	appset bool
+	mews   []layer
+	// names holds the index in mews of the layer of every name of the document.
+	names map[string]int
+	timer *loadTimer
+	// report describes the appid layer with WithProfile.
+	report *LayerReport
+}
 
-	if !ok {
-		return nil, fmt.Errorf("does not contain `%s`", appid)
+func (set *layerSet) add(key string, mw layer, scored bool) error {
+	if key == set.appid {
+		set.app, set.appset = mw.value, true
+		set.report = mw.report
+		return nil
+	}
+	set.layer(key, mw, scored)
+	return nil
+}
+
+// layer records the top-level value key of the document, a layer when scored.
+func (set *layerSet) layer(key string, mw layer, scored bool) {
+	i, seen := set.names[key]
+	switch {
+	case scored && seen:
+		mw.name = key
+		set.mews[i] = mw
+	case scored:
+		if set.names == nil {
+			set.names = make(map[string]int)
+		}
+		set.names[key] = len(set.mews)
+		mw.name = key
+		set.mews = append(set.mews, mw)
+	case seen:
+		// Replaced by a value that is not a layer, see layers.
+		set.mews[i].value = nil
+		delete(set.names, key)
 	}
+}
 
-	mews := make([]string, 0, len(r))
-	smews := make(map[string]int)
+// next starts the values of another document: its names no longer replace the layers of
+// the earlier documents, see LoadFiles.
+func (set *layerSet) next() {
+	set.names = nil
+}
 
-	for key,mw := range r {
-		if key == appid {
-			continue
+// layers returns the collected layers in document order, without those replaced.
+func (set *layerSet) layers() []layer {
+	mews := set.mews[:0]
+	for _, mw := range set.mews {
+		if mw.value != nil {
+			mews = append(mews, mw)
 		}
-		switch v := mw.(type) {
-		case map[string]any:
-			score, ok := v["meow-score"].(float64)
-			if !ok {
-				continue
+	}
+	set.mews, set.names = mews, nil
+	return mews
+}
+
+// ordered returns the collected layers in merge order.
+func (set *layerSet) ordered() ([]layer, error) {
+	if !set.appset {
+		return nil, fmt.Errorf("does not contain `%s`", set.appid)
+	}
+	if set.app == nil {
+		return nil, fmt.Errorf("`%s` is not a JSON object", set.appid)
+	}
+	if set.timer != nil {
+		start := time.Now()
+		defer func() { set.timer.stats.Sort += time.Since(start) }()
+	}
+	mews := set.layers()
+	set.timer.phase("sort", "", func() { mews = orderLayers(set.appid, mews, set.app) })
+	mews[len(mews)-1].report = set.report
+	return mews, nil
+}
+
+// orderLayers sorts the scored layers by increasing score and appends the appid layer,
+// which always takes precedence. Layers with the same score are ordered by name, so the
+// merge does not depend on the order of the document; layers with the same name as well keep
+// the order of the documents, see LoadFiles.
+func orderLayers(appid string, mews []layer, app map[string]any) []layer {
+	sort.Stable(byPrecedence(mews))
+	return append(mews, layer{name: appid, value: app})
+}
+
+// byPrecedence orders layers from the lowest to the highest precedence.
+type byPrecedence []layer
+
+func (p byPrecedence) Len() int      { return len(p) }
+func (p byPrecedence) Swap(i, j int) { p[i], p[j] = p[j], p[i] }
+func (p byPrecedence) Less(i, j int) bool {
+	if p[i].score != p[j].score {
+		return p[i].score < p[j].score
+	}
+	return p[i].name < p[j].name
+}
+
+// mergeLayers merges layers given in merge order: a key of a later layer takes precedence
+// over the same key of the earlier ones. The layers are walked from the last one and every
+// key is written once, by the first layer that defines it. With deep, nested objects are
+// merged as well, see deepMerge.
+func mergeLayers(mews []layer, deep bool) map[string]any {
+	if deep {
+		objs := make([]map[string]any, len(mews))
+		for i, mw := range mews {
+			objs[len(mews)-1-i] = mw.value
+		}
+		return deepMerge(objs)
+	}
+	size := 0
+	for _, mw := range mews {
+		if len(mw.value) > size {
+			size = len(mw.value)
+		}
+	}
+	m := make(map[string]any, size)
+	for i := len(mews) - 1; i >= 0; i-- {
+		for k, v := range mews[i].value {
+			if _, ok := m[k]; !ok {
+				m[k] = v
 			}
-			sregs[key] = int(score)
-			regs = append(regs, key)
-		default:
-			continue
 		}
 	}
-	sort.Slice(mws, func(i, j int) bool { return smws[mws[i]] < smews[mews[j]] })
-	tubus = append(mws, appid)
+	return m
+}
 
-	meow := new(Meow)
-	meow.meow = make(map[string]any)
-	for _, key := range regs {
-		for k, v := range r[key].(map[string]any) {
-			meow.meow[k] = v
+// newMeow wraps a merged map and builds the structures requested by the options. It fails
+// when the meow does not match the schema of the options.
+func newMeow(appid string, m map[string]any, o *options) (*Meow, error) {
+	meow := &Meow{meow: m, lazy: o.lazy}
+	if o.arena {
+		if a, err := newArena(m); err == nil {
+			meow.meow, meow.arena, meow.lazy = nil, a, false
 		}
 	}
+	return meow.setup(appid, o)
+}
+
+// newArenaMeow returns the meow of a merged meow stored in an arena.
+func newArenaMeow(appid string, a *arena, o *options) (*Meow, error) {
+	return (&Meow{arena: a}).setup(appid, o)
+}
+
+// setup prepares the lookups of a meow for its merged values as the options ask.
+func (meow *Meow) setup(appid string, o *options) (*Meow, error) {
 	meow.appid = appid
+	meow.generation = generations.Add(1)
+	meow.metrics = o.metrics
+	meow.deep, meow.numbers = o.deep, o.numbers
+	meow.overlay = compileOverlay(o.overlay)
+	if o.index && meow.arena == nil {
+		meow.index = buildIndex(meow.root())
+	}
+	if o.views {
+		meow.views = new(views)
+	}
+	if o.schema != nil {
+		meow.schema = o.schema
+		if err := o.schema.validate(meow); err != nil {
+			return nil, err
+		}
+	}
 	return meow, nil
 }
 
-// Value retrieves the value of the meow in a sequence of keys. The type is 'any'
-func (meow *Meow) Value(key ...string) any {
-	switch len(key) {
-	case 0:
-		return meow.meow
-	case 1:
-		return meow.meow[key[0]]
-	default:
-		v := meow.meow
-		last := len(key) - 1
-		ok := false
-		for i := 0; i < last; i++ {
-			v, ok = v[key[i]].(map[string]any)
-			if !ok {
-				return nil
+// decodeLayer reads the next top-level value of the document. Values that are not objects
+// are skipped. Members of an object are kept as raw JSON until its `meow-score` is seen, so
+// unscored layers never get decoded; with all set, the object is decoded regardless. With
+// WithLazy, the members are kept as raw JSON until first read.
+func decodeLayer(dec *json.Decoder, all bool, o *options) (layer, bool, error) {
+	var mw layer
+	tok, err := dec.Token()
+	if err != nil {
+		return mw, false, err
+	}
+	d, ok := tok.(json.Delim)
+	if !ok {
+		return mw, false, nil
+	}
+	if d == '[' {
+		for dec.More() {
+			if err := dec.Decode(&skipValue{}); err != nil {
+				return mw, false, err
 			}
 		}
-		return v[key[last]]
+		_, err := dec.Token()
+		return mw, false, err
 	}
-}
 
-// Exists checks of the meow is defined in a sequence of keys.
-func (meow *Meow) Exists(key ...string) bool {
-	switch len(key) {
-	case 0:
-		return len(meow.meow) > 0
-	case 1:
-		_, ok := meow.meow[key[0]]
-		return ok
-	default:
-		v, ok := meow.meow[key[0]].(map[string]any)
+	var pending map[string]json.RawMessage
+	scored := false
+	if all {
+		mw.value = make(map[string]any)
+	}
+	for dec.More() {
+		tok, err := dec.Token()
+		if err != nil {
+			return mw, false, err
+		}
+		k := tok.(string)
+		if mw.value != nil && !o.lazy {
+			var v any
+			if err := dec.Decode(&v); err != nil {
+				return mw, false, err
+			}
+			mw.value[k] = v
+			if score, ok := numberOf(v); ok && k == "meow-score" {
+				mw.score = int(score)
+				scored = true
+			}
+			continue
+		}
+
+		var raw json.RawMessage
+		if err := dec.Decode(&raw); err != nil {
+			return mw, false, err
+		}
+		var score any
+		if k == "meow-score" {
+			if err := unmarshal(raw, &score, o.numbers); err != nil {
+				return mw, false, err
+			}
+		}
+		s, ok := numberOf(score)
+		if mw.value != nil {
+			if ok {
+				mw.score = int(s)
+				scored = true
+				mw.value[k] = score
+			} else {
+				mw.value[k] = newLazy(raw, o)
+			}
+			continue
+		}
 		if !ok {
-			return false
+			if pending == nil {
+				pending = make(map[string]json.RawMessage)
+			}
+			pending[k] = raw
+			continue
 		}
-		for i, k := range key[1:] {
-			if i == len(key)-1 {
-				_, ok := v[k]
-				return ok
+		mw.score = int(s)
+		scored = true
+		mw.value = make(map[string]any, len(pending)+1)
+		mw.value[k] = score
+		for pk, praw := range pending {
+			if o.lazy {
+				mw.value[pk] = newLazy(praw, o)
+				continue
 			}
-			v, ok = v[k].(map[string]any)
-			if !ok {
-				return false
+			var v any
+			if err := unmarshal(praw, &v, o.numbers); err != nil {
+				return mw, false, err
 			}
+			mw.value[pk] = v
 		}
-		return false
+		pending = nil
+	}
+	if _, err := dec.Token(); err != nil {
+		return mw, false, err
 	}
+	return mw, scored, nil
 }
 
-// ValueString returns the value of a sequence of keys. If the result is not a string or the meow is not defined,
-func (meow *Meow) ValueString(key ...string) string {
-	value := meow.Value(key...)
-	if value == nil {
-		return ""
+// unmarshal decodes a JSON value, keeping numbers as json.Number when numbers is set.
+func unmarshal(data []byte, v any, numbers bool) error {
+	if !numbers {
+		return json.Unmarshal(data, v)
 	}
-	v, ok := value.(string)
-	if !ok {
-		return ""
+	dec := json.NewDecoder(bytes.NewReader(data))
+	dec.UseNumber()
+	return dec.Decode(v)
+}
+
+// numberOf returns the value of a number decoded as a float64 or as a json.Number.
+func numberOf(v any) (float64, bool) {
+	switch v := v.(type) {
+	case float64:
+		return v, true
+	case json.Number:
+		f, err := v.Float64()
+		return f, err == nil
+	}
+	return 0, false
+}
+
+// Value retrieves the value of the meow in a sequence of keys. The type is 'any'
+func (meow *Meow) Value(key ...string) any {
+	if meow.metrics != nil {
+		meow.metrics.read(key)
+	}
+	if len(key) == 0 {
+		return meow.root()
+	}
+	if len(key) == 1 && meow.arena == nil && meow.overlay == nil {
+		return resolve(meow.meow[key[0]])
 	}
+	v, _ := meow.lookup(key)
 	return v
 }
 
-// ValueInt returns the value of a sequence of keys. If the result is not an int or the meow is not defined,.
-func (meow *Meow) ValueInt(key ...string) int {
-	value := meow.Value(key...)
-	if value == nil {
-		return 0
+// Exists checks of the meow is defined in a sequence of keys.
+func (meow *Meow) Exists(key ...string) bool {
+	if meow.metrics != nil {
+		meow.metrics.read(key)
+	}
+	if len(key) == 0 {
+		if meow.overlay != nil {
+			return len(meow.root()) > 0
+		}
+		if meow.arena != nil {
+			return meow.arena.len() > 0
+		}
+		return len(meow.meow) > 0
+	}
+	_, ok := meow.lookup(key)
+	return ok
+}
+
+// lookup walks a non-empty sequence of keys down the meow.
+func (meow *Meow) lookup(key []string) (any, bool) {
+	if meow.overlay != nil {
+		if v, ok, handled := meow.lookupOverlay(key); handled {
+			return v, ok
+		}
+	}
+	return meow.baseLookup(key)
+}
+
+// baseLookup walks a non-empty sequence of keys down the merged layers.
+func (meow *Meow) baseLookup(key []string) (any, bool) {
+	if meow.arena != nil {
+		n, ok := meow.arena.find(key)
+		if !ok {
+			return nil, false
+		}
+		return meow.arena.get(n), true
+	}
+	if meow.index != nil && len(key) > 1 {
+		return meow.index.lookup(key)
 	}
-	a, ok := value.(float64)
+	if len(key) == 1 {
+		value, ok := meow.meow[key[0]]
+		return resolve(value), ok
+	}
+	v, ok := resolve(meow.meow[key[0]]).(map[string]any)
 	if !ok {
-		return 0
+		return nil, false
 	}
-	if a != float64(int(a)) {
-		return 0
+	last := len(key) - 1
+	for i := 1; i < last; i++ {
+		v, ok = v[key[i]].(map[string]any)
+		if !ok {
+			return nil, false
+		}
 	}
-	return int(a)
+	value, ok := v[key[last]]
+	return value, ok
+}
+
+// ValueString returns the value of a sequence of keys. If the result is not a string or the meow is not defined,
+func (meow *Meow) ValueString(key ...string) string {
+	return asString(meow.Value(key...))
+}
+
+// ValueInt returns the value of a sequence of keys. If the result is not an int or the meow is not defined,.
+func (meow *Meow) ValueInt(key ...string) int {
+	return asInt(meow.Value(key...))
 }
 
 // ValueStringMap returns the value of a sequence of keys. If the result is not a map[string]string the meow is not defined,
-// the method returns nil.
+// the method returns nil. With WithViews or WithSchema the result may be shared and must not be modified.
 func (meow *Meow) ValueStringMap(key ...string) map[string]string {
-	value := meow.Value(key...)
-	if value == nil {
-		return nil
+	return view(meow, viewStringMap, key, asStringMap)
+}
+
+// ValueStringSlice returns the value of a sequence of keys. If the result is not a []string or the meow is not defined,
+// the method returns nil. With WithViews or WithSchema the result may be shared and must not be modified.
+func (meow *Meow) ValueStringSlice(key ...string) []string {
+	return view(meow, viewStringSlice, key, asStringSlice)
+}
+
+// ValueIntMap returns the value of a sequence of keys. If the result is not a map[string]int or the meow is not defined,
+// the method returns nil. With WithViews or WithSchema the result may be shared and must not be modified.
+func (meow *Meow) ValueIntMap(key ...string) map[string]int {
+	return view(meow, viewIntMap, key, asIntMap)
+}
+
+// ValueIntSlice returns the value of a sequence of keys. If the result is not a []int or the meow is not defined,
+// the method returns nil. With WithViews or WithSchema the result may be shared and must not be modified.
+func (meow *Meow) ValueIntSlice(key ...string) []int {
+	return view(meow, viewIntSlice, key, asIntSlice)
+}
+
+func asString(value any) string {
+	v, ok := value.(string)
+	if !ok {
+		return ""
 	}
+	return v
+}
+
+func asInt(value any) int {
+	a, _ := asInteger(value)
+	return a
+}
+
+// asInteger converts a number holding an int, decoded as a float64 or as a json.Number.
+func asInteger(value any) (int, bool) {
+	switch a := value.(type) {
+	case float64:
+		if a != float64(int(a)) {
+			return 0, false
+		}
+		return int(a), true
+	case json.Number:
+		if i, err := strconv.ParseInt(string(a), 10, strconv.IntSize); err == nil {
+			return int(i), true
+		}
+		f, err := a.Float64()
+		if err != nil {
+			return 0, false
+		}
+		return asInteger(f)
+	}
+	return 0, false
+}
+
+func asStringMap(value any) map[string]string {
 	v, ok := value.(map[string]any)
 	if !ok {
 		return nil
@@ -212,12 +638,7 @@ func (meow *Meow) ValueStringMap(key ...string) map[string]string {
 	return m
 }
 
-// ValueStringSlice returns the value of a sequence of keys. If the result is not a []string or the meow is not defined,
-func (meow *Meow) ValueStringSlice(key ...string) []string {
-	value := meow.Value(key...)
-	if value == nil {
-		return nil
-	}
+func asStringSlice(value any) []string {
 	v, ok := value.([]any)
 	if !ok {
 		return nil
@@ -233,50 +654,34 @@ func (meow *Meow) ValueStringSlice(key ...string) []string {
 	return m
 }
 
-// ValueIntMap returns the value of a sequence of keys. If the result is not a map[string]int or the meow is not defined,
-func (meow *Meow) ValueIntMap(key ...string) map[string]int {
-	value := meow.Value(key...)
-	if value == nil {
-		return nil
-	}
+func asIntMap(value any) map[string]int {
 	v, ok := value.(map[string]any)
 	if !ok {
 		return nil
 	}
 	m := make(map[string]int)
 	for k, sa := range v {
-		a, ok := sa.(float64)
+		a, ok := asInteger(sa)
 		if !ok {
 			return nil
 		}
-		if a != float64(int(a)) {
-			return nil
-		}
-		m[k] = int(a)
+		m[k] = a
 	}
 	return m
 }
 
-// ValueIntSlice returns the value of a sequence of keys. If the result is not a []int or the meow is not defined,
-func (meow *Meow) ValueIntSlice(key ...string) []int {
-	value := meow.Value(key...)
-	if value == nil {
-		return nil
-	}
+func asIntSlice(value any) []int {
 	v, ok := value.([]any)
 	if !ok {
 		return nil
 	}
 	m := make([]int, 0, len(v))
 	for _, sa := range v {
-		a, ok := sa.(float64)
+		a, ok := asInteger(sa)
 		if !ok {
 			return nil
 		}
-		if a != float64(int(a)) {
-			return nil
-		}
-		m = append(m, int(a))
+		m = append(m, a)
 	}
 
 	return m
@@ -1,6 +1,10 @@
 package meow
 
 import (
+	"hash/maphash"
+	"os"
+	"path/filepath"
+	"reflect"
 	"strings"
 	"testing"
 )
@@ -98,3 +102,111 @@ func TestMeow(t *testing.T) {
 	}
 
 }
+
+func TestMeowStream(t *testing.T) {
+
+	doc := `{
+		"unscored": {"a": {"deep": [1, 2, 3]}, "b": "B"},
+		"list": [{"x": 1}, "y", 3],
+		"late": {"key-test": "late", "meow-score": 20},
+		"scalar": 5,
+		"chess": {"key-test": "chess"}
+	}`
+	meow, err := LoadReader("chess", strings.NewReader(doc))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if meow.Exists("a") || meow.Exists("b") {
+		t.Errorf("Error: unscored layer merged\n\n%v", meow.meow)
+	}
+	if meow.ValueString("key-test") != "chess" {
+		t.Errorf("Error: found `%s`\n\n%v", meow.ValueString("key-test"), meow.meow)
+	}
+	if meow.ValueInt("meow-score") != 20 {
+		t.Errorf("Error: found `%d`\n\n%v", meow.ValueInt("meow-score"), meow.meow)
+	}
+
+	for _, doc := range []string{"", " ", "[]", `{"chess": 1}`, `{"other": {}}`, `{"chess": {}} x`, `{"chess": {"a": }}`} {
+		if _, err := LoadReader("chess", strings.NewReader(doc)); err == nil {
+			t.Errorf("Error: no error for `%s`", doc)
+		}
+	}
+}
+
+func TestMeowPrecedence(t *testing.T) {
+
+	doc := `{
+		"b": {"meow-score": 5, "key": "b", "b": 1},
+		"c": {"meow-score": 4, "key": "c", "c": 1},
+		"a": {"meow-score": 5, "key": "a", "a": 1},
+		"chess": {}
+	}`
+	for i := 0; i < 20; i++ {
+		meow, err := LoadReader("chess", strings.NewReader(doc))
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		if meow.ValueString("key") != "b" || len(meow.meow) != 5 {
+			t.Fatalf("Error: found `%s`\n\n%v", meow.ValueString("key"), meow.meow)
+		}
+	}
+}
+
+func TestMeowDuplicates(t *testing.T) {
+
+	// As with json.Unmarshal, the last value of a top-level name is the one merged.
+	meowFile := filepath.Join(t.TempDir(), "meow.json")
+	loaders := map[string]func(doc string) (*Meow, error){
+		"stream":   func(doc string) (*Meow, error) { return LoadReader("chess", strings.NewReader(doc)) },
+		"parallel": func(doc string) (*Meow, error) { return LoadReader("chess", strings.NewReader(doc), WithParallel(2)) },
+		"fast": func(doc string) (*Meow, error) {
+			return LoadReader("chess", strings.NewReader(doc), WithDecoder(FastDecoder{}))
+		},
+		"lazy": func(doc string) (*Meow, error) { return LoadReader("chess", strings.NewReader(doc), WithLazy()) },
+		"shared": func(doc string) (*Meow, error) {
+			s, err := LoadSharedReader(strings.NewReader(doc))
+			if err != nil {
+				return nil, err
+			}
+			return s.Meow("chess")
+		},
+		"watch": func(doc string) (*Meow, error) {
+			os.WriteFile(meowFile, []byte(doc), 0o600)
+			src := &fileSource{appid: "chess", meowFile: meowFile, o: newOptions(nil), seed: maphash.MakeSeed()}
+			return src.load()
+		},
+		"files": func(doc string) (*Meow, error) {
+			os.WriteFile(meowFile, []byte(doc), 0o600)
+			return LoadFiles("chess", []string{meowFile})
+		},
+	}
+	for _, c := range []struct {
+		doc      string
+		expected map[string]any
+	}{
+		{`{"a": {"meow-score": 1, "x": 1}, "a": {"meow-score": 0, "y": 2}, "chess": {}}`, map[string]any{"meow-score": float64(0), "y": float64(2)}},
+		{`{"a": {"meow-score": 1, "x": 1}, "a": 5, "chess": {}}`, map[string]any{}},
+		{`{"a": {"meow-score": 1, "x": 1}, "a": {"y": 2}, "chess": {}}`, map[string]any{}},
+		{`{"a": {"x": 1}, "a": {"meow-score": 1, "y": 2}, "chess": {}}`, map[string]any{"meow-score": float64(1), "y": float64(2)}},
+		{`{"a": {"meow-score": 1, "x": 1}, "a": 5, "a": {"meow-score": 2, "z": 3}, "chess": {}}`, map[string]any{"meow-score": float64(2), "z": float64(3)}},
+		{`{"chess": 1, "chess": {"z": 3}}`, map[string]any{"z": float64(3)}},
+		{`{"chess": {"z": 3}, "chess": {"w": 4}}`, map[string]any{"w": float64(4)}},
+		{`{"chess": {"z": 3}, "chess": 1}`, nil},
+	} {
+		for name, load := range loaders {
+			meow, err := load(c.doc)
+			if c.expected == nil {
+				if err == nil {
+					t.Errorf("Error: %s: no error for `%s`", name, c.doc)
+				}
+				continue
+			}
+			if err != nil {
+				t.Fatalf("Error: %s: `%s`: %s", name, c.doc, err)
+			}
+			if !reflect.DeepEqual(meow.root(), c.expected) {
+				t.Errorf("Error: %s: `%s`: found %v, expected %v", name, c.doc, meow.root(), c.expected)
+			}
+		}
+	}
+}
@@ -0,0 +1,55 @@
+//go:build linux
+
+package meow
+
+import (
+	"path/filepath"
+	"sync/atomic"
+	"syscall"
+)
+
+// notify signals changes in the directory of meowFile through inotify. Watching the directory
+// catches editors and deployment tools that replace the file instead of writing it.
+func notify(meowFile string) (<-chan struct{}, func()) {
+	fd, err := syscall.InotifyInit1(syscall.IN_CLOEXEC)
+	if err != nil {
+		return nil, func() {}
+	}
+	mask := uint32(syscall.IN_CLOSE_WRITE | syscall.IN_MOVED_TO | syscall.IN_CREATE | syscall.IN_DELETE)
+	wd, err := syscall.InotifyAddWatch(fd, filepath.Dir(meowFile), mask)
+	if err != nil {
+		syscall.Close(fd)
+		return nil, func() {}
+	}
+
+	events := make(chan struct{}, 1)
+	var stopped atomic.Bool
+	go func() {
+		defer close(events)
+		defer syscall.Close(fd)
+		buf := make([]byte, 4096)
+		for {
+			n, err := syscall.Read(fd, buf)
+			if stopped.Load() {
+				return
+			}
+			if err == syscall.EINTR {
+				continue
+			}
+			if err != nil {
+				return
+			}
+			if n > 0 {
+				select {
+				case events <- struct{}{}:
+				default:
+				}
+			}
+		}
+	}()
+	// Removing the watch queues an IN_IGNORED event, which wakes up the blocked read.
+	return events, func() {
+		stopped.Store(true)
+		syscall.InotifyRmWatch(fd, uint32(wd))
+	}
+}
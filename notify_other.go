@@ -0,0 +1,8 @@
+//go:build !linux
+
+package meow
+
+// notify has no file system notifications on this platform: watchers rely on polling.
+func notify(meowFile string) (<-chan struct{}, func()) {
+	return nil, func() {}
+}
@@ -0,0 +1,164 @@
+package meow
+
+import (
+	"net/http"
+	"runtime"
+)
+
+// Option configures how a meow is loaded, see LoadReader.
+type Option func(*options)
+
+type options struct {
+	index   bool
+	views   bool
+	deep    bool
+	numbers bool
+	lazy    bool
+	arena   bool
+	workers int
+	decoder Decoder
+	client  *http.Client
+	metrics *Metrics
+	overlay *Overlay
+	schema  *Schema
+	profile func(*LoadReport)
+	// timer measures the load in progress, see LoadReader.
+	timer *loadTimer
+}
+
+func newOptions(opts []Option) *options {
+	o := new(options)
+	for _, opt := range opts {
+		opt(o)
+	}
+	return o
+}
+
+// decode decodes a JSON value with the decoder of the options.
+func (o *options) decode(data []byte) (any, error) {
+	if o.decoder == nil {
+		return StdDecoder{}.Decode(data, o.numbers)
+	}
+	return o.decoder.Decode(data, o.numbers)
+}
+
+// WithIndex builds a flattened index of all nested key sequences at load time, so that a
+// lookup of several keys costs a single hash probe instead of one per key.
+func WithIndex() Option {
+	return func(o *options) {
+		o.index = true
+	}
+}
+
+// WithViews memoises the results of ValueStringMap, ValueStringSlice, ValueIntMap and
+// ValueIntSlice per sequence of keys. Repeated calls return the same read-only view
+// without allocating; the views live as long as the loaded meow.
+func WithViews() Option {
+	return func(o *options) {
+		o.views = true
+	}
+}
+
+// WithDeepMerge merges nested objects across layers: a layer overriding `g1.a1` keeps the
+// other keys of `g1` defined by the layers below. Without it, a layer replaces whole
+// top-level values. Objects defined by a single layer are shared instead of copied.
+func WithDeepMerge() Option {
+	return func(o *options) {
+		o.deep = true
+	}
+}
+
+// WithNumbers decodes numbers as json.Number instead of float64, so integers beyond 2^53
+// keep their exact value. Value then returns json.Number for numbers; the typed helpers,
+// Get, Lookup and Bind accept both forms.
+func WithNumbers() Option {
+	return func(o *options) {
+		o.numbers = true
+	}
+}
+
+// WithParallel decodes the top-level layers of a document on up to workers goroutines, then
+// merges them in score order exactly like the sequential load. A document read from an
+// io.Reader is read into memory first. A workers value of 0 means runtime.GOMAXPROCS(0).
+func WithParallel(workers int) Option {
+	return func(o *options) {
+		if workers <= 0 {
+			workers = runtime.GOMAXPROCS(0)
+		}
+		o.workers = workers
+	}
+}
+
+// WithLazy keeps the top-level values of the layers as raw JSON and decodes each of them on
+// first access, so a large meow of which an application reads a few keys is loaded at the
+// cost of a syntax check. Decoded values are cached and safe for concurrent readers.
+// WithIndex, Bind and WriteSnapshot decode the whole meow.
+func WithLazy() Option {
+	return func(o *options) {
+		o.lazy = true
+	}
+}
+
+// WithDecoder decodes the document with d instead of encoding/json, for instance with
+// FastDecoder. A document read from an io.Reader is read into memory first. MessagePack and
+// CBOR documents are detected without it, WithDecoder(MessagePack{}) or WithDecoder(CBOR{})
+// only enforces their format.
+func WithDecoder(d Decoder) Option {
+	return func(o *options) {
+		o.decoder = d
+	}
+}
+
+// WithHTTPClient fetches remote meows with client instead of a client with a 30s timeout.
+func WithHTTPClient(client *http.Client) Option {
+	return func(o *options) {
+		o.client = client
+	}
+}
+
+// WithMetrics records the statistics of LoadReader, LoadFile and LoadMapped and counts the
+// reads of the meow with Value and Exists into m. Lookups through a Key, a Batch, Get and
+// Lookup are not counted.
+func WithMetrics(m *Metrics) Option {
+	return func(o *options) {
+		o.metrics = m
+	}
+}
+
+// WithArena stores the merged meow in flat tables instead of maps, see arena: the garbage
+// collector then scans a few pointers instead of a graph of the size of the meow. Lookups
+// cost a binary search per key, Get and Lookup do not allocate. Value builds the objects and
+// arrays it returns anew on every call, and so do Bind and Diff; WithIndex is ignored.
+func WithArena() Option {
+	return func(o *options) {
+		o.arena = true
+	}
+}
+
+// WithOverlay overrides the values of the meow with ov, see Overlay. A meow loaded again
+// with the same options keeps the overrides. The registries of WatchFile, WatchFiles and
+// WatchURL follow ov, so changes of ov reach their readers without a reload.
+func WithOverlay(ov *Overlay) Option {
+	return func(o *options) {
+		o.overlay = ov
+	}
+}
+
+// WithSchema fails the load of a meow that does not match s, see ParseSchema. The typed views
+// the schema fixes, such as ValueStringMap of an object of strings, are built at load and
+// returned as they are, see Schema: they are shared between callers and must not be modified.
+func WithSchema(s *Schema) Option {
+	return func(o *options) {
+		o.schema = s
+	}
+}
+
+// WithProfile profiles LoadReader, LoadFile and LoadMapped and hands the report of every load
+// to fn, see LoadReport. The phases of the load run in runtime/trace regions of a meow.Load
+// task and under the pprof labels meow_phase and meow_layer, so execution traces and CPU
+// profiles taken meanwhile show where the time goes, layer by layer.
+func WithProfile(fn func(*LoadReport)) Option {
+	return func(o *options) {
+		o.profile = fn
+	}
+}
@@ -0,0 +1,334 @@
+package meow
+
+import (
+	"encoding/json"
+	"flag"
+	"fmt"
+	"os"
+	"sort"
+	"strings"
+	"sync"
+)
+
+// Overlay holds values overriding keys of a meow above all its layers, from environment
+// variables, command-line flags or code. Overrides apply in the order they are set: a
+// later override of a key, or of one of its parents, replaces the earlier ones.
+//
+// An overlay is attached to a meow with WithOverlay at load time or with Meow.Overlay
+// afterwards. Lookups probe the small index of the overrides before the merged layers, so
+// changing an override never merges the layers again. A meow keeps the overrides it was
+// built with: Registry.Overlay publishes the changes to the readers of a registry.
+//
+// An overlay may be changed while meows are loaded with it on other goroutines.
+type Overlay struct {
+	mu       sync.Mutex
+	sets     []override
+	compiled *overlay
+	// stale is set when compiled does not hold the latest overrides.
+	stale   bool
+	next    int
+	follows []overlayFollower
+}
+
+type overlayFollower struct {
+	id int
+	fn func()
+}
+
+type override struct {
+	key   []string
+	value any
+}
+
+// NewOverlay returns an empty overlay.
+func NewOverlay() *Overlay {
+	return new(Overlay)
+}
+
+// Set overrides the value of a sequence of keys, the whole meow for no key. The registries
+// following ov publish the change before Set returns, see Registry.Overlay.
+func (ov *Overlay) Set(value any, key ...string) {
+	ov.set(override{append([]string(nil), key...), value})
+}
+
+// set applies overrides and notifies the followers once.
+func (ov *Overlay) set(sets ...override) {
+	ov.mu.Lock()
+	ov.sets = append(ov.sets, sets...)
+	ov.stale = true
+	follows := ov.follows
+	ov.mu.Unlock()
+	for _, f := range follows {
+		f.fn()
+	}
+}
+
+// compile returns the index of the overrides, compiled once per change of ov.
+func (ov *Overlay) compile() *overlay {
+	ov.mu.Lock()
+	defer ov.mu.Unlock()
+	if ov.stale {
+		ov.compiled, ov.stale = compileOverrides(ov.sets), false
+	}
+	return ov.compiled
+}
+
+// follow registers fn to be called after every change of ov and returns the function
+// cancelling it.
+func (ov *Overlay) follow(fn func()) (cancel func()) {
+	ov.mu.Lock()
+	defer ov.mu.Unlock()
+	ov.next++
+	id := ov.next
+	ov.follows = append(ov.follows[:len(ov.follows):len(ov.follows)], overlayFollower{id, fn})
+	return func() {
+		ov.mu.Lock()
+		defer ov.mu.Unlock()
+		for i, f := range ov.follows {
+			if f.id == id {
+				ov.follows = append(ov.follows[:i:i], ov.follows[i+1:]...)
+				return
+			}
+		}
+	}
+}
+
+// Env overrides keys from the environment variables whose name starts with prefix, in the
+// order of their names. The rest of the name gives the keys: `__` separates them, the
+// letters are lowercased and `_` becomes `-`, so MEOW_DB__MAX_CONNS sets `db.max-conns`
+// with the prefix MEOW_. Values are decoded as JSON if they are valid JSON, taken as strings
+// otherwise.
+func (ov *Overlay) Env(prefix string) {
+	var names []string
+	values := make(map[string]string)
+	for _, kv := range os.Environ() {
+		name, value, _ := strings.Cut(kv, "=")
+		if strings.HasPrefix(name, prefix) && len(name) > len(prefix) {
+			names = append(names, name)
+			values[name] = value
+		}
+	}
+	sort.Strings(names)
+	sets := make([]override, 0, len(names))
+	for _, name := range names {
+		key := strings.Split(name[len(prefix):], "__")
+		for i, k := range key {
+			key[i] = strings.ReplaceAll(strings.ToLower(k), "_", "-")
+		}
+		sets = append(sets, override{key, overrideValue(values[name])})
+	}
+	if len(sets) > 0 {
+		ov.set(sets...)
+	}
+}
+
+// Var defines a flag name of fs that can be repeated, each `-name key.path=value` overriding
+// a sequence of keys separated by dots. Values are decoded like with Env.
+func (ov *Overlay) Var(fs *flag.FlagSet, name string, usage string) {
+	fs.Var(overlayFlag{ov}, name, usage)
+}
+
+type overlayFlag struct {
+	ov *Overlay
+}
+
+func (f overlayFlag) String() string {
+	return ""
+}
+
+func (f overlayFlag) Set(s string) error {
+	path, value, ok := strings.Cut(s, "=")
+	if !ok || path == "" {
+		return fmt.Errorf("`%s` is not of the form key.path=value", s)
+	}
+	f.ov.Set(overrideValue(value), strings.Split(path, ".")...)
+	return nil
+}
+
+func overrideValue(s string) any {
+	var v any
+	if err := json.Unmarshal([]byte(s), &v); err != nil {
+		return s
+	}
+	return v
+}
+
+// Overlay returns a meow with the values of meow overridden by ov, in place of any overlay
+// of meow. The merged layers are shared: the cost is in proportion to the overrides. The
+// schema of meow, see WithSchema, does not reject the overrides.
+func (meow *Meow) Overlay(ov *Overlay) *Meow {
+	n := &Meow{
+		appid:      meow.appid,
+		meowFile:   meow.meowFile,
+		meow:       meow.meow,
+		index:      meow.index,
+		lazy:       meow.lazy,
+		deep:       meow.deep,
+		numbers:    meow.numbers,
+		generation: generations.Add(1),
+		metrics:    meow.metrics,
+		arena:      meow.arena,
+		overlay:    compileOverlay(ov),
+	}
+	if meow.views != nil {
+		n.views = new(views)
+	}
+	if meow.schema != nil {
+		// The overrides cannot fail here: an overlay that does not match the schema keeps
+		// no typed views.
+		n.schema = meow.schema
+		_ = n.schema.validate(n)
+	}
+	return n
+}
+
+// overlay indexes overrides as a tree of their keys, probed one key at a time. Every parent
+// of an override has an entry, so a lookup of keys without overrides stops at the first probe.
+type overlay struct {
+	root *overlayEntry
+}
+
+type overlayEntry struct {
+	key      []string
+	value    any
+	set      bool
+	children []*overlayEntry
+	kids     map[string]*overlayEntry
+}
+
+// compileOverlay returns the index of the overrides of ov, nil when ov holds no override.
+// It is shared by the meows built with ov until ov changes.
+func compileOverlay(ov *Overlay) *overlay {
+	if ov == nil {
+		return nil
+	}
+	return ov.compile()
+}
+
+// compileOverrides applies overrides in order and indexes the result, nil without
+// overrides.
+func compileOverrides(sets []override) *overlay {
+	if len(sets) == 0 {
+		return nil
+	}
+	type node struct {
+		value any
+		set   bool
+		kids  map[string]*node
+	}
+	root := new(node)
+	for _, s := range sets {
+		n := root
+		for _, k := range s.key {
+			if n.set {
+				// Overriding a key below an override: the override becomes the parent.
+				obj, _ := n.value.(map[string]any)
+				n.kids = make(map[string]*node, len(obj))
+				for kk, vv := range obj {
+					n.kids[kk] = &node{value: vv, set: true}
+				}
+				n.value, n.set = nil, false
+			}
+			if n.kids == nil {
+				n.kids = make(map[string]*node)
+			}
+			c, ok := n.kids[k]
+			if !ok {
+				c = new(node)
+				n.kids[k] = c
+			}
+			n = c
+		}
+		n.value, n.set, n.kids = s.value, true, nil
+	}
+
+	var flatten func(key []string, n *node) *overlayEntry
+	flatten = func(key []string, n *node) *overlayEntry {
+		e := &overlayEntry{key: key, value: n.value, set: n.set}
+		if len(n.kids) > 0 {
+			e.kids = make(map[string]*overlayEntry, len(n.kids))
+		}
+		names := make([]string, 0, len(n.kids))
+		for k := range n.kids {
+			names = append(names, k)
+		}
+		sort.Strings(names)
+		for _, k := range names {
+			c := flatten(append(key[:len(key):len(key)], k), n.kids[k])
+			e.children = append(e.children, c)
+			e.kids[k] = c
+		}
+		return e
+	}
+	return &overlay{root: flatten(nil, root)}
+}
+
+// covers reports whether an override may change the value of key.
+func (x *overlay) covers(key []string) bool {
+	if x.root.set || len(key) == 0 {
+		return true
+	}
+	_, ok := x.root.kids[key[0]]
+	return ok
+}
+
+// lookup returns the value of key with the overrides applied. It reports handled false
+// when no override applies to key, the merged layers then hold its value.
+func (meow *Meow) lookupOverlay(key []string) (v any, ok bool, handled bool) {
+	e := meow.overlay.root
+	for i, k := range key {
+		if e.set {
+			v, ok := descend(e.value, key[i:])
+			return v, ok, true
+		}
+		if e = e.kids[k]; e == nil {
+			return nil, false, false
+		}
+	}
+	if e.set {
+		return e.value, true, true
+	}
+	return meow.mergedAt(e), true, true
+}
+
+func descend(v any, key []string) (any, bool) {
+	for _, k := range key {
+		obj, ok := v.(map[string]any)
+		if !ok {
+			return nil, false
+		}
+		if v, ok = obj[k]; !ok {
+			return nil, false
+		}
+	}
+	return v, true
+}
+
+// mergedAt returns the object at the keys of e, with the overrides below e applied. It is
+// built once per meow.
+func (meow *Meow) mergedAt(e *overlayEntry) map[string]any {
+	if m, ok := meow.overlaid.Load(e); ok {
+		return m.(map[string]any)
+	}
+	var src map[string]any
+	if len(e.key) == 0 {
+		src = meow.baseRoot()
+	} else {
+		v, _ := meow.baseLookup(e.key)
+		src, _ = v.(map[string]any)
+	}
+	m := make(map[string]any, len(src)+len(e.children))
+	for k, v := range src {
+		m[k] = v
+	}
+	for _, c := range e.children {
+		k := c.key[len(c.key)-1]
+		if c.set {
+			m[k] = c.value
+		} else {
+			m[k] = meow.mergedAt(c)
+		}
+	}
+	actual, _ := meow.overlaid.LoadOrStore(e, m)
+	return actual.(map[string]any)
+}
@@ -0,0 +1,213 @@
+package meow
+
+import (
+	"flag"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestOverlay(t *testing.T) {
+
+	t.Setenv("MEOWTEST_KEY_TEST1", "from env")
+	t.Setenv("MEOWTEST_G1__C1", "3")
+	ov := NewOverlay()
+	ov.Env("MEOWTEST_")
+	fs := flag.NewFlagSet("test", flag.ContinueOnError)
+	fs.SetOutput(io.Discard)
+	ov.Var(fs, "set", "override a key")
+	if err := fs.Parse([]string{"-set", "map-string.c=C", "-set", "db.pool={\"min\": 1}", "-set", "db.pool.max=8"}); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if err := fs.Parse([]string{"-set", "novalue"}); err == nil {
+		t.Errorf("Error: no error for a flag without value")
+	}
+	ov.Set("S2", "string")
+	ov.Set("gone", "int", "x")
+
+	for _, opts := range [][]Option{nil, {WithLazy()}, {WithIndex()}, {WithArena()}} {
+		base, err := LoadReader("chess", strings.NewReader(body), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		loaded, err := LoadReader("chess", strings.NewReader(body), append(opts, WithOverlay(ov))...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		for _, meow := range []*Meow{base.Overlay(ov), loaded} {
+			if meow.ValueString("key-test1") != "from env" || Get[string](meow, "key-test1") != "from env" {
+				t.Errorf("Error: %d options: found `%s`", len(opts), meow.ValueString("key-test1"))
+			}
+			if meow.ValueString("g1", "a1") != "A" || meow.ValueInt("g1", "c1") != 3 || Get[int](meow, "g1", "c1") != 3 {
+				t.Errorf("Error: %d options: found %v", len(opts), meow.Value("g1"))
+			}
+			if !reflect.DeepEqual(meow.ValueStringMap("map-string"), map[string]string{"a": "A", "b": "B", "c": "C"}) {
+				t.Errorf("Error: %d options: found %v", len(opts), meow.Value("map-string"))
+			}
+			if !reflect.DeepEqual(meow.Value("db"), map[string]any{"pool": map[string]any{"min": 1.0, "max": 8.0}}) {
+				t.Errorf("Error: %d options: found %v", len(opts), meow.Value("db"))
+			}
+			if meow.ValueString("string") != "S2" || meow.ValueString("slice-string", "x") != "" {
+				t.Errorf("Error: %d options: found `%s`", len(opts), meow.ValueString("string"))
+			}
+			if meow.ValueString("int", "x") != "gone" || meow.Value("int", "x", "y") != nil || meow.Exists("int", "y") {
+				t.Errorf("Error: %d options: found %v", len(opts), meow.Value("int"))
+			}
+			root := meow.Value().(map[string]any)
+			if root["key-test1"] != "from env" || root["key-test"] != "branch chess" || !meow.Exists() {
+				t.Errorf("Error: %d options: found %v", len(opts), root)
+			}
+			values := make([]any, 2)
+			if n := meow.Read(CompileBatch([]string{"key-test1"}, []string{"g1", "c1"}), values); n != 2 || values[0] != "from env" {
+				t.Errorf("Error: %d options: found %v", len(opts), values)
+			}
+			var keys []string
+			meow.Range([]string{"g1"}, "", func(k string, v any) bool {
+				keys = append(keys, k)
+				return true
+			})
+			if !reflect.DeepEqual(keys, []string{"a1", "c1"}) {
+				t.Errorf("Error: %d options: found %v", len(opts), keys)
+			}
+			if !reflect.DeepEqual(Diff(base, meow), [][]string{{"db"}, {"g1", "c1"}, {"int"}, {"key-test1"}, {"map-string", "c"}, {"string"}}) {
+				t.Errorf("Error: %d options: found %v", len(opts), Diff(base, meow))
+			}
+			if meow.Generation() <= base.Generation() {
+				t.Errorf("Error: %d options: generation not increased", len(opts))
+			}
+		}
+		if base.ValueString("key-test1") == "from env" || base.Overlay(NewOverlay()).overlay != nil {
+			t.Errorf("Error: %d options: base modified", len(opts))
+		}
+	}
+
+	// A later override of a parent replaces the earlier overrides below it.
+	ov = NewOverlay()
+	ov.Set(1, "g1", "a1")
+	ov.Set(map[string]any{"b": 2}, "g1")
+	meow, err := LoadReader("chess", strings.NewReader(body), WithOverlay(ov))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if !reflect.DeepEqual(meow.Value("g1"), map[string]any{"b": 2}) || meow.Exists("g1", "a1") {
+		t.Errorf("Error: found %v", meow.Value("g1"))
+	}
+	// Keys holding the separator of the index stay apart from nested keys.
+	sep := NewOverlay()
+	sep.Set(1.0, "x"+pathSep+"y")
+	sep.Set(2.0, "z", "w")
+	meow = meow.Overlay(sep)
+	if meow.Exists("x", "y") || meow.Exists("z"+pathSep+"w") || meow.ValueInt("x"+pathSep+"y") != 1 || meow.ValueInt("z", "w") != 2 {
+		t.Errorf("Error: found %v", meow.Value())
+	}
+	// Setting no key overrides the whole meow.
+	ov.Set(map[string]any{"only": true})
+	if meow = meow.Overlay(ov); !reflect.DeepEqual(meow.Value(), map[string]any{"only": true}) || meow.Exists("g1") {
+		t.Errorf("Error: found %v", meow.Value())
+	}
+}
+
+func TestOverlayRegistry(t *testing.T) {
+
+	n := 0
+	reg, err := NewRegistry(func() (*Meow, error) {
+		n++
+		return LoadReader("chess", strings.NewReader(fmt.Sprintf(`{"chess": {"n": %d, "a": "A"}}`, n)))
+	})
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	published := 0
+	reg.Subscribe(func(old, new *Meow) { published++ })
+
+	// A change of a followed overlay is published before Set returns, and reloads keep it.
+	ov := NewOverlay()
+	cancel := reg.Overlay(ov)
+	if published != 0 {
+		t.Errorf("Error: empty overlay published")
+	}
+	ov.Set("live", "a")
+	if reg.Meow().ValueString("a") != "live" || published != 1 {
+		t.Errorf("Error: found `%s` after %d publications", reg.Meow().ValueString("a"), published)
+	}
+	t.Setenv("MEOWTEST_B", "1")
+	t.Setenv("MEOWTEST_C", "2")
+	ov.Env("MEOWTEST_")
+	if reg.Meow().ValueInt("c") != 2 || published != 2 {
+		t.Errorf("Error: found `%v` after %d publications", reg.Meow().Value(), published)
+	}
+	if err := reg.Reload(); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if reg.Meow().ValueInt("n") != 2 || reg.Meow().ValueString("a") != "live" {
+		t.Errorf("Error: found `%v` after reload", reg.Meow().Value())
+	}
+
+	cancel()
+	ov.Set("gone", "a")
+	if reg.Meow().ValueString("a") != "live" {
+		t.Errorf("Error: change published after cancel")
+	}
+	if err := reg.Reload(); err != nil || reg.Meow().ValueString("a") != "A" {
+		t.Errorf("Error: found `%s` after cancel", reg.Meow().ValueString("a"))
+	}
+}
+
+func TestOverlayWatched(t *testing.T) {
+
+	meowFile := filepath.Join(t.TempDir(), "meow.json")
+	write := func(n int) {
+		tmp := meowFile + ".tmp"
+		os.WriteFile(tmp, []byte(fmt.Sprintf(`{"chess": {"n": %d, "a": "A"}}`, n)), 0o600)
+		os.Rename(tmp, meowFile)
+	}
+	write(0)
+	ov := NewOverlay()
+	w, err := WatchFile("chess", meowFile, time.Millisecond, WithOverlay(ov))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	defer w.Close()
+
+	// Overrides set while the file is reloaded and read reach the readers of the registry.
+	var wg sync.WaitGroup
+	stop := make(chan struct{})
+	for i := 0; i < 4; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				select {
+				case <-stop:
+					return
+				default:
+					_ = w.Registry().Meow().ValueString("a")
+				}
+			}
+		}()
+	}
+	for i := 1; i <= 50; i++ {
+		ov.Set(float64(i), "o")
+		if found := w.Registry().Meow().ValueInt("o"); found != i {
+			t.Errorf("Error: found `%d`, expected `%d`", found, i)
+		}
+		if i%5 == 0 {
+			write(i)
+		}
+	}
+	close(stop)
+	wg.Wait()
+	write(1000)
+	if err := w.Registry().Reload(); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if meow := w.Registry().Meow(); meow.ValueInt("n") != 1000 || meow.ValueInt("o") != 50 {
+		t.Errorf("Error: found `%v`", meow.Value())
+	}
+}
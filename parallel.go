@@ -0,0 +1,36 @@
+package meow
+
+import "sync"
+
+type decodedSpan struct {
+	layer  layer
+	scored bool
+	err    error
+}
+
+// decodeParallel decodes the spans of a document on a bounded pool of goroutines. The
+// results keep the order of the spans, so merging them is independent of the scheduling.
+func decodeParallel(appid string, data []byte, spans []span, o *options) []decodedSpan {
+	decoded := make([]decodedSpan, len(spans))
+	next := make(chan int)
+	var wg sync.WaitGroup
+	workers := o.workers
+	if workers > len(spans) {
+		workers = len(spans)
+	}
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for i := range next {
+				decoded[i] = decodeTimed(appid, data, spans[i], o)
+			}
+		}()
+	}
+	for i := range spans {
+		next <- i
+	}
+	close(next)
+	wg.Wait()
+	return decoded
+}
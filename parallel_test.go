@@ -0,0 +1,39 @@
+package meow
+
+import (
+	"bytes"
+	"reflect"
+	"strings"
+	"testing"
+)
+
+func TestParallel(t *testing.T) {
+
+	for _, doc := range [][]byte{[]byte(body), synthetic(2000, 40)} {
+		appid := "chess"
+		if !bytes.Contains(doc, []byte(`"chess"`)) {
+			appid = "app"
+		}
+		expected, err := LoadReader(appid, bytes.NewReader(doc))
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		for _, workers := range []int{0, 2, 7, 64} {
+			meow, err := LoadReader(appid, bytes.NewReader(doc), WithParallel(workers))
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			if !reflect.DeepEqual(meow.meow, expected.meow) {
+				t.Errorf("Error: %d workers: results differ", workers)
+			}
+		}
+	}
+
+	for _, doc := range []string{"", `{"chess": 1}`, `{"other": {}}`, `{"a": {"meow-score": 1}, "chess": {"a": }}`, `{"chess": {}} x`} {
+		_, err1 := LoadReader("chess", strings.NewReader(doc))
+		_, err2 := LoadReader("chess", strings.NewReader(doc), WithParallel(4))
+		if err1 == nil || err2 == nil {
+			t.Errorf("Error: no error for `%s`", doc)
+		}
+	}
+}
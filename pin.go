@@ -0,0 +1,62 @@
+package meow
+
+import "sync/atomic"
+
+// Pinned is a Key of a registry that Publish resolves again for every new meow, see
+// Registry.Pin. Reading it is a single atomic load: unlike a LiveKey it neither loads the
+// current meow of the registry nor compares it, and the slot holding the Key is padded to a
+// cache line of its own, so reads on any number of cores never share a line with a write.
+type Pinned struct {
+	key atomic.Pointer[Key]
+	_   [56]byte
+}
+
+// Pin returns a Pinned of a sequence of keys. The registry keeps the Pinned up to date until
+// Unpin; pin the few keys read on every call, such as feature flags, and Compile the others.
+func (r *Registry) Pin(key ...string) *Pinned {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	p := new(Pinned)
+	p.key.Store(r.Meow().Compile(key...))
+	r.pins = append(r.pins, p)
+	return p
+}
+
+// Unpin stops p from following the registry: p keeps the Key of the last published meow.
+func (r *Registry) Unpin(p *Pinned) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	for i, q := range r.pins {
+		if q == p {
+			r.pins = append(r.pins[:i:i], r.pins[i+1:]...)
+			return
+		}
+	}
+}
+
+// Key returns the Key resolved against the last meow published by the registry.
+func (p *Pinned) Key() *Key {
+	return p.key.Load()
+}
+
+// Value returns the pinned value, see Meow.Value.
+func (p *Pinned) Value() any {
+	return p.key.Load().value
+}
+
+// ValueString returns the pinned value as a string, see Meow.ValueString.
+func (p *Pinned) ValueString() string {
+	return p.key.Load().str
+}
+
+// ValueInt returns the pinned value as an int, see Meow.ValueInt.
+func (p *Pinned) ValueInt() int {
+	return p.key.Load().num
+}
+
+// repin resolves the pinned keys against meow. It runs in Publish before the subscribers.
+func (r *Registry) repin(meow *Meow) {
+	for _, p := range r.pins {
+		p.key.Store(p.key.Load().Rebind(meow))
+	}
+}
@@ -0,0 +1,101 @@
+package meow
+
+import (
+	"fmt"
+	"strings"
+	"sync"
+	"testing"
+	"unsafe"
+)
+
+func TestPinned(t *testing.T) {
+
+	n := 0
+	reg, err := NewRegistry(func() (*Meow, error) {
+		n++
+		return LoadReader("chess", strings.NewReader(fmt.Sprintf(`{"chess": {"n": %d, "s": "v%d"}}`, n, n)))
+	})
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if unsafe.Sizeof(Pinned{}) != 64 {
+		t.Errorf("Error: Pinned is %d bytes", unsafe.Sizeof(Pinned{}))
+	}
+
+	p := reg.Pin("n")
+	s := reg.Pin("s")
+	var seen []int
+	reg.Subscribe(func(old, new *Meow) {
+		seen = append(seen, p.ValueInt())
+	})
+
+	stop := make(chan struct{})
+	var wg sync.WaitGroup
+	for i := 0; i < 4; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				select {
+				case <-stop:
+					return
+				default:
+					if v := p.ValueInt(); v < 1 || v > 3 {
+						t.Errorf("Error: found `%d`", v)
+						return
+					}
+				}
+			}
+		}()
+	}
+	if err := reg.Reload(); err != nil {
+		t.Errorf("Error: %s", err)
+	}
+	close(stop)
+	wg.Wait()
+
+	if p.ValueInt() != 2 || s.ValueString() != "v2" || p.Key().Meow() != reg.Meow() {
+		t.Errorf("Error: found `%d` `%s`", p.ValueInt(), s.ValueString())
+	}
+	if len(seen) != 1 || seen[0] != 2 {
+		t.Errorf("Error: subscribers saw `%v`", seen)
+	}
+
+	reg.Unpin(p)
+	if err := reg.Reload(); err != nil {
+		t.Errorf("Error: %s", err)
+	}
+	if p.ValueInt() != 2 || s.ValueString() != "v3" || s.Value() != "v3" {
+		t.Errorf("Error: found `%d` `%s`", p.ValueInt(), s.ValueString())
+	}
+}
+
+func BenchmarkPinned(b *testing.B) {
+	reg, err := NewRegistry(func() (*Meow, error) { return lookupMeow, nil })
+	if err != nil {
+		b.Fatalf("Error: %s", err)
+	}
+	live := reg.Compile("db", "pool", "name")
+	pinned := reg.Pin("db", "pool", "name")
+	b.Run("value", func(b *testing.B) {
+		b.RunParallel(func(pb *testing.PB) {
+			for pb.Next() {
+				_ = reg.Meow().ValueString("db", "pool", "name")
+			}
+		})
+	})
+	b.Run("live", func(b *testing.B) {
+		b.RunParallel(func(pb *testing.PB) {
+			for pb.Next() {
+				_ = live.Key().ValueString()
+			}
+		})
+	})
+	b.Run("pinned", func(b *testing.B) {
+		b.RunParallel(func(pb *testing.PB) {
+			for pb.Next() {
+				_ = pinned.ValueString()
+			}
+		})
+	})
+}
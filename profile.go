@@ -0,0 +1,156 @@
+package meow
+
+import (
+	"context"
+	"fmt"
+	"runtime/pprof"
+	"runtime/trace"
+	"sort"
+	"strings"
+	"text/tabwriter"
+	"time"
+)
+
+// LoadReport describes a load profiled with WithProfile. Nodes counts the values decoded
+// during the load: the objects, arrays and scalars of the layers, without the members
+// WithLazy leaves undecoded. Layers lists the layers in merge order, from the lowest
+// precedence to the appid layer.
+type LoadReport struct {
+	LoadStats
+	Nodes  int
+	Layers []LayerReport
+}
+
+// LayerReport describes a layer of a profiled load. Bytes is the size of the layer in the
+// document, Keys the number of its top-level keys, Set the number of those that made it to
+// the meow and Overridden the number of those hidden, or deep merged with WithDeepMerge, by
+// a layer of higher precedence. Merge is the time spent merging the keys of the layer.
+type LayerReport struct {
+	Name       string
+	Score      int
+	Bytes      int64
+	Nodes      int
+	Parse      time.Duration
+	Merge      time.Duration
+	Keys       int
+	Set        int
+	Overridden int
+}
+
+// String formats the report as a table of the layers, the slowest to merge first.
+func (r *LoadReport) String() string {
+	var b strings.Builder
+	fmt.Fprintf(&b, "meow load: %d bytes, %d nodes, %d keys, read %s, parse %s, sort %s, merge %s, %d allocs\n",
+		r.Bytes, r.Nodes, r.Keys, r.Read, r.Parse, r.Sort, r.Merge, r.Allocs)
+	layers := append([]LayerReport(nil), r.Layers...)
+	sort.SliceStable(layers, func(i, j int) bool { return layers[i].Merge > layers[j].Merge })
+	w := tabwriter.NewWriter(&b, 0, 8, 2, ' ', tabwriter.AlignRight)
+	fmt.Fprintln(w, "layer\tscore\tbytes\tnodes\tparse\tmerge\tkeys\tset\toverridden\t")
+	for _, l := range layers {
+		fmt.Fprintf(w, "%s\t%d\t%d\t%d\t%s\t%s\t%d\t%d\t%d\t\n",
+			l.Name, l.Score, l.Bytes, l.Nodes, l.Parse, l.Merge, l.Keys, l.Set, l.Overridden)
+	}
+	w.Flush()
+	return b.String()
+}
+
+// phase runs fn in a runtime/trace region named after the phase of the load, with the pprof
+// labels meow_phase and meow_layer, so CPU profiles and execution traces break the load
+// down by phase and layer. Without WithProfile it only runs fn.
+func (t *loadTimer) phase(name, layer string, fn func()) {
+	if t == nil || t.profile == nil {
+		fn()
+		return
+	}
+	pprof.Do(t.ctx, pprof.Labels("meow_phase", name, "meow_layer", layer), func(ctx context.Context) {
+		if layer != "" {
+			trace.Log(ctx, "meow_layer", layer)
+		}
+		trace.WithRegion(ctx, "meow."+name, fn)
+	})
+}
+
+// parse runs decode, the decoding of the top-level value key, in the parse phase. When
+// profiling, the decoded layer carries its report, whose size the caller fills in.
+func (t *loadTimer) parse(key string, decode func() (layer, bool, error)) (layer, bool, error) {
+	if t == nil || t.profile == nil {
+		return decode()
+	}
+	var mw layer
+	var scored bool
+	var err error
+	start := time.Now()
+	t.phase("parse", key, func() { mw, scored, err = decode() })
+	if err == nil && mw.value != nil {
+		mw.report = &LayerReport{Name: key, Score: mw.score, Nodes: countNodes(mw.value),
+			Parse: time.Since(start), Keys: len(mw.value)}
+	}
+	return mw, scored, err
+}
+
+// merge merges the layers like mergeLayers. When profiling, it merges one layer at a time,
+// from the highest precedence down, and records the report of every layer.
+func (t *loadTimer) merge(mews []layer, deep bool) map[string]any {
+	if t == nil || t.profile == nil {
+		return mergeLayers(mews, deep)
+	}
+	objs := make([]map[string]any, len(mews))
+	for i, mw := range mews {
+		objs[len(mews)-1-i] = mw.value
+	}
+	m := make(map[string]any, len(objs[0]))
+	t.layers = make([]LayerReport, len(mews))
+	for i := len(mews) - 1; i >= 0; i-- {
+		mw, r := mews[i], &t.layers[i]
+		if mw.report != nil {
+			*r = *mw.report
+		} else {
+			*r = LayerReport{Name: mw.name, Score: mw.score, Nodes: countNodes(mw.value), Keys: len(mw.value)}
+		}
+		lower := objs[len(mews)-i:]
+		start := time.Now()
+		t.phase("merge", mw.name, func() {
+			for k, v := range mw.value {
+				if _, ok := m[k]; ok {
+					r.Overridden++
+					continue
+				}
+				if deep {
+					v = mergeValue(lower, k, v)
+				}
+				m[k] = v
+				r.Set++
+			}
+		})
+		r.Merge = time.Since(start)
+	}
+	return m
+}
+
+// countNodes counts the decoded values of v.
+func countNodes(v any) int {
+	n := 1
+	switch v := v.(type) {
+	case map[string]any:
+		for _, e := range v {
+			n += countNodes(e)
+		}
+	case []any:
+		for _, e := range v {
+			n += countNodes(e)
+		}
+	case *lazyValue:
+		n = 0
+	}
+	return n
+}
+
+// report builds the report of the load and hands it to the function of WithProfile.
+func (t *loadTimer) report() {
+	r := &LoadReport{LoadStats: t.stats, Layers: t.layers}
+	for _, l := range t.layers {
+		r.Nodes += l.Nodes
+	}
+	t.task.End()
+	t.profile(r)
+}
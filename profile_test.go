@@ -0,0 +1,68 @@
+package meow
+
+import (
+	"bytes"
+	"reflect"
+	"runtime/trace"
+	"strings"
+	"testing"
+)
+
+func TestProfile(t *testing.T) {
+
+	for _, opts := range [][]Option{nil, {WithDeepMerge()}, {WithParallel(4)}, {WithLazy()}, {WithArena()}} {
+		var report *LoadReport
+		meow, err := LoadReader("chess", strings.NewReader(body), append(opts, WithProfile(func(r *LoadReport) { report = r }))...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		expected, err := LoadReader("chess", strings.NewReader(body), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		if !reflect.DeepEqual(meow.root(), expected.root()) {
+			t.Errorf("Error: found\n%v\nexpected\n%v", meow.root(), expected.root())
+		}
+		if report == nil {
+			t.Fatalf("Error: no report")
+		}
+		var names []string
+		for _, l := range report.Layers {
+			names = append(names, l.Name)
+		}
+		if !reflect.DeepEqual(names, []string{"general2", "general1", "general3", "chess"}) {
+			t.Errorf("Error: found layers %v", names)
+		}
+		g3, chess := report.Layers[2], report.Layers[3]
+		if g3.Score != 11 || g3.Keys != 3 || g3.Set != 2 || g3.Overridden != 1 || g3.Bytes == 0 {
+			t.Errorf("Error: found %+v", g3)
+		}
+		if chess.Set != chess.Keys || chess.Overridden != 0 || chess.Bytes == 0 {
+			t.Errorf("Error: found %+v", chess)
+		}
+		if report.Nodes == 0 || report.Bytes != int64(len(body)) || report.Keys == 0 {
+			t.Errorf("Error: found %+v", report.LoadStats)
+		}
+		if s := report.String(); !strings.Contains(s, "general3") || !strings.Contains(s, "overridden") {
+			t.Errorf("Error: found\n%s", s)
+		}
+	}
+}
+
+func TestProfileTrace(t *testing.T) {
+
+	var buf bytes.Buffer
+	if err := trace.Start(&buf); err != nil {
+		t.Skipf("tracing unavailable: %s", err)
+	}
+	_, err := LoadReader("chess", strings.NewReader(body), WithProfile(func(*LoadReport) {}))
+	trace.Stop()
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	for _, s := range []string{"meow.Load", "meow.parse", "meow.merge", "general3"} {
+		if !bytes.Contains(buf.Bytes(), []byte(s)) {
+			t.Errorf("Error: trace without `%s`", s)
+		}
+	}
+}
@@ -0,0 +1,108 @@
+package meow
+
+import (
+	"encoding/base64"
+	"fmt"
+	"sort"
+	"strings"
+)
+
+// Range calls fn for the members of the object at a sequence of keys prefix, the merged
+// object for no key, in increasing key order until fn returns false. The values are the
+// values of the meow and must not be modified. When fn stops the iteration, Range returns
+// a token that resumes it after the last member passed to fn; the token is empty once all
+// members have been passed. An empty token starts from the first member.
+//
+// The keys of an object are sorted on its first Range and kept with the meow, so that
+// resuming costs a binary search. With WithArena, the keys are stored sorted.
+func (meow *Meow) Range(prefix []string, token string, fn func(key string, value any) bool) (string, error) {
+	after, resume, err := parseToken(token)
+	if err != nil {
+		return "", err
+	}
+	if meow.arena != nil && meow.overlay == nil {
+		return meow.rangeArena(prefix, after, resume, fn)
+	}
+	obj := meow.meow
+	if meow.overlay != nil || meow.arena != nil {
+		obj = meow.root()
+	}
+	if len(prefix) > 0 {
+		v, _ := meow.lookup(prefix)
+		var ok bool
+		if obj, ok = v.(map[string]any); !ok {
+			return "", fmt.Errorf("`%s` is not a JSON object", strings.Join(prefix, "."))
+		}
+	}
+	keys := meow.sortedKeys(prefix, obj)
+	i := 0
+	if resume {
+		i = sort.SearchStrings(keys, after)
+		if i < len(keys) && keys[i] == after {
+			i++
+		}
+	}
+	for ; i < len(keys); i++ {
+		if !fn(keys[i], resolve(obj[keys[i]])) {
+			return newToken(keys[i], i+1 < len(keys)), nil
+		}
+	}
+	return "", nil
+}
+
+func (meow *Meow) rangeArena(prefix []string, after string, resume bool, fn func(string, any) bool) (string, error) {
+	a := meow.arena
+	n, ok := a.find(prefix)
+	kind, count, first := a.node(n)
+	if !ok || kind != nodeObject {
+		return "", fmt.Errorf("`%s` is not a JSON object", strings.Join(prefix, "."))
+	}
+	lo, end := int(first), int(first)+int(count)
+	if resume {
+		lo += sort.Search(int(count), func(i int) bool { return a.key(int(first)+i) > after })
+	}
+	for i := lo; i < end; i++ {
+		k := a.key(i)
+		if !fn(k, a.get(a.entryNode(i))) {
+			return newToken(k, i+1 < end), nil
+		}
+	}
+	return "", nil
+}
+
+// sortedKeys returns the sorted keys of obj, the object at prefix, sorted once per meow.
+// The keys are cached by the length-prefixed encoding of the views, which tells apart the
+// root from the object at "" and keys containing pathSep from nested paths.
+func (meow *Meow) sortedKeys(prefix []string, obj map[string]any) []string {
+	var buf [64]byte
+	path := string(viewKey(buf[:0], 'r', prefix))
+	if keys, ok := meow.sorted.Load(path); ok {
+		return keys.([]string)
+	}
+	keys := make([]string, 0, len(obj))
+	for k := range obj {
+		keys = append(keys, k)
+	}
+	sort.Strings(keys)
+	meow.sorted.Store(path, keys)
+	return keys
+}
+
+// newToken returns the token resuming a Range after key, empty when no member follows.
+func newToken(key string, more bool) string {
+	if !more {
+		return ""
+	}
+	return "k" + base64.RawURLEncoding.EncodeToString([]byte(key))
+}
+
+func parseToken(token string) (string, bool, error) {
+	if token == "" {
+		return "", false, nil
+	}
+	key, err := base64.RawURLEncoding.DecodeString(token[1:])
+	if token[0] != 'k' || err != nil {
+		return "", false, fmt.Errorf("invalid range token `%s`", token)
+	}
+	return string(key), true, nil
+}
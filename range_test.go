@@ -0,0 +1,85 @@
+package meow
+
+import (
+	"bytes"
+	"reflect"
+	"sort"
+	"testing"
+)
+
+func TestRange(t *testing.T) {
+
+	doc := synthetic(2000, 10)
+	for _, opts := range [][]Option{nil, {WithLazy()}, {WithIndex()}, {WithArena()}} {
+		meow, err := LoadReader("app", bytes.NewReader(doc), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		for _, prefix := range [][]string{nil, {"g9_0"}} {
+			expected, _ := meow.Value(prefix...).(map[string]any)
+			keys := make([]string, 0, len(expected))
+			for k := range expected {
+				keys = append(keys, k)
+			}
+			sort.Strings(keys)
+
+			// Pages of 7 members resumed with their token.
+			var found []string
+			token := ""
+			for {
+				n := 0
+				token, err = meow.Range(prefix, token, func(k string, v any) bool {
+					if !reflect.DeepEqual(v, expected[k]) {
+						t.Errorf("Error: %d options: `%s`: found %v, expected %v", len(opts), k, v, expected[k])
+					}
+					found = append(found, k)
+					n++
+					return n < 7
+				})
+				if err != nil {
+					t.Fatalf("Error: %s", err)
+				}
+				if token == "" {
+					break
+				}
+			}
+			if !reflect.DeepEqual(found, keys) {
+				t.Errorf("Error: %d options: %v: found %d keys, expected %d", len(opts), prefix, len(found), len(keys))
+			}
+		}
+		if _, err := meow.Range([]string{"k9_0"}, "", func(string, any) bool { return true }); err == nil {
+			t.Errorf("Error: %d options: no error for a string", len(opts))
+		}
+		if _, err := meow.Range(nil, "bad", func(string, any) bool { return true }); err == nil {
+			t.Errorf("Error: %d options: no error for a bad token", len(opts))
+		}
+	}
+
+	// The root, the object at "" and the objects whose keys hold pathSep are cached apart.
+	doc = []byte(`{"app": {"": {"x": 1}, "a": {"b": {"y": 2}}, "a\u001fb": {"z": 3}, "r": 4}}`)
+	for _, opts := range [][]Option{nil, {WithArena()}} {
+		meow, err := LoadReader("app", bytes.NewReader(doc), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		for _, c := range []struct {
+			prefix []string
+			keys   []string
+		}{
+			{nil, []string{"", "a", "a\x1fb", "r"}},
+			{[]string{""}, []string{"x"}},
+			{[]string{"a", "b"}, []string{"y"}},
+			{[]string{"a\x1fb"}, []string{"z"}},
+			{nil, []string{"", "a", "a\x1fb", "r"}},
+		} {
+			var found []string
+			meow.Range(c.prefix, "", func(k string, v any) bool {
+				found = append(found, k)
+				return true
+			})
+			if !reflect.DeepEqual(found, c.keys) {
+				t.Errorf("Error: %d options: %q: found %q, expected %q", len(opts), c.prefix, found, c.keys)
+			}
+		}
+	}
+}
@@ -0,0 +1,176 @@
+package meow
+
+import (
+	"fmt"
+	"sync"
+	"sync/atomic"
+)
+
+// Registry holds the current meow of an application. A reload builds the new meow off to
+// the side and publishes it with a single atomic store, so readers on any goroutine keep
+// calling Meow without locking while the reload happens.
+//
+//	reg, err := NewRegistry(func() (*Meow, error) { return LoadFile(appid, meowFile) })
+type Registry struct {
+	current atomic.Pointer[Meow]
+	load    func() (*Meow, error)
+	reload  sync.Mutex
+	// overlay, guarded by reload, is applied to every meow loaded, see Overlay.
+	overlay *Overlay
+
+	mu   sync.Mutex
+	next int
+	subs []subscriber
+	pins []*Pinned
+}
+
+type subscriber struct {
+	id int
+	fn func(old, new *Meow)
+}
+
+// NewRegistry loads the first meow with load and keeps load for Reload.
+func NewRegistry(load func() (*Meow, error)) (*Registry, error) {
+	if load == nil {
+		return nil, fmt.Errorf("no meow loader specified")
+	}
+	meow, err := load()
+	if err != nil {
+		return nil, err
+	}
+	if meow == nil {
+		return nil, fmt.Errorf("no meow loaded")
+	}
+	r := &Registry{load: load}
+	r.current.Store(meow)
+	return r, nil
+}
+
+// Meow returns the current meow. The result is never modified by a reload.
+func (r *Registry) Meow() *Meow {
+	return r.current.Load()
+}
+
+// Reload loads a new meow and publishes it. On error the current meow stays in place.
+// The loader may return a nil meow to report that nothing changed. Reloads are serialized,
+// so a loader keeping state between calls, such as the sources of WatchFile, is never run
+// concurrently.
+func (r *Registry) Reload() error {
+	r.reload.Lock()
+	defer r.reload.Unlock()
+	meow, err := r.load()
+	if err != nil {
+		return err
+	}
+	if meow != nil {
+		r.Publish(r.overlaid(meow))
+	}
+	return nil
+}
+
+// Overlay makes the registry follow the overrides of ov: the current meow is published again
+// with the overrides applied whenever ov changes, before Overlay.Set returns, and so is every
+// meow reloaded. The overrides replace those the meows were loaded with, see Meow.Overlay;
+// a loader attaching ov with WithOverlay saves the reloads from applying it again. ov must
+// not be changed from a subscriber of the registry. The returned function stops following ov.
+func (r *Registry) Overlay(ov *Overlay) (cancel func()) {
+	republish := func() {
+		if meow := r.Meow(); r.overlay == ov {
+			if n := r.overlaid(meow); n != meow {
+				r.Publish(n)
+			}
+		}
+	}
+	r.reload.Lock()
+	r.overlay = ov
+	republish()
+	r.reload.Unlock()
+	unfollow := ov.follow(func() {
+		r.reload.Lock()
+		defer r.reload.Unlock()
+		republish()
+	})
+	return func() {
+		unfollow()
+		r.reload.Lock()
+		defer r.reload.Unlock()
+		if r.overlay == ov {
+			r.overlay = nil
+		}
+	}
+}
+
+// overlaid returns meow with the overrides of the followed overlay, meow itself when it
+// already has them.
+func (r *Registry) overlaid(meow *Meow) *Meow {
+	if r.overlay == nil {
+		return meow
+	}
+	if x := r.overlay.compile(); meow.overlay != x {
+		return meow.Overlay(r.overlay)
+	}
+	return meow
+}
+
+// Publish replaces the current meow and notifies the subscribers in subscription order.
+// Publications are serialized, so subscribers see the meows in the order they were published.
+func (r *Registry) Publish(meow *Meow) {
+	if meow == nil {
+		return
+	}
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	old := r.current.Swap(meow)
+	r.repin(meow)
+	for _, s := range r.subs {
+		s.fn(old, meow)
+	}
+}
+
+// Subscribe registers fn to be called with the previous and the new meow whenever a meow is
+// published. fn runs on the publishing goroutine and must not call Publish or Subscribe.
+// The returned function cancels the subscription.
+func (r *Registry) Subscribe(fn func(old, new *Meow)) (cancel func()) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	r.next++
+	id := r.next
+	r.subs = append(r.subs, subscriber{id, fn})
+	return func() {
+		r.mu.Lock()
+		defer r.mu.Unlock()
+		for i, s := range r.subs {
+			if s.id == id {
+				r.subs = append(r.subs[:i:i], r.subs[i+1:]...)
+				return
+			}
+		}
+	}
+}
+
+// Compile returns a Key of the registry that follows reloads, see Meow.Compile.
+func (r *Registry) Compile(key ...string) *LiveKey {
+	l := &LiveKey{registry: r}
+	l.key.Store(r.Meow().Compile(key...))
+	return l
+}
+
+// LiveKey is a Key that is resolved again the first time it is read after a reload.
+type LiveKey struct {
+	registry *Registry
+	key      atomic.Pointer[Key]
+}
+
+// Key returns the Key resolved against the current meow of the registry.
+func (l *LiveKey) Key() *Key {
+	k := l.key.Load()
+	meow := l.registry.Meow()
+	if k.meow == meow {
+		return k
+	}
+	n := k.Rebind(meow)
+	if !l.key.CompareAndSwap(k, n) {
+		return l.Key()
+	}
+	return n
+}
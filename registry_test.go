@@ -0,0 +1,117 @@
+package meow
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestRegistry(t *testing.T) {
+
+	n := 0
+	reg, err := NewRegistry(func() (*Meow, error) {
+		n++
+		if n == 3 {
+			return nil, fmt.Errorf("broken meow")
+		}
+		return LoadReader("chess", strings.NewReader(fmt.Sprintf(`{"chess": {"n": %d}}`, n)))
+	})
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+
+	k := reg.Compile("n")
+	var published []int
+	cancel := reg.Subscribe(func(old, new *Meow) {
+		published = append(published, old.ValueInt("n"), new.ValueInt("n"))
+	})
+
+	stop := make(chan struct{})
+	var wg sync.WaitGroup
+	for i := 0; i < 4; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				select {
+				case <-stop:
+					return
+				default:
+					if v := reg.Meow().ValueInt("n"); v < 1 || v > 2 {
+						t.Errorf("Error: found `%d`", v)
+						return
+					}
+					_ = k.Key().ValueInt()
+				}
+			}
+		}()
+	}
+
+	if err := reg.Reload(); err != nil {
+		t.Errorf("Error: %s", err)
+	}
+	if err := reg.Reload(); err == nil {
+		t.Errorf("Error: broken reload published")
+	}
+	close(stop)
+	wg.Wait()
+
+	if reg.Meow().ValueInt("n") != 2 || k.Key().ValueInt() != 2 {
+		t.Errorf("Error: found `%d` after reload", k.Key().ValueInt())
+	}
+	if fmt.Sprint(published) != "[1 2]" {
+		t.Errorf("Error: published %v", published)
+	}
+
+	cancel()
+	reg.Publish(reg.Meow())
+	if len(published) != 2 {
+		t.Errorf("Error: cancelled subscriber notified")
+	}
+}
+
+func TestRegistryReloadWatched(t *testing.T) {
+
+	meowFile := filepath.Join(t.TempDir(), "meow.json")
+	if err := os.WriteFile(meowFile, []byte(`{"chess": {"n": 0}}`), 0o600); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	w, err := WatchFile("chess", meowFile, time.Millisecond)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	defer w.Close()
+
+	// Reloads racing the watcher goroutine run the file source one at a time.
+	var wg sync.WaitGroup
+	for i := 0; i < 4; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for j := 0; j < 50; j++ {
+				if err := w.Registry().Reload(); err != nil {
+					t.Errorf("Error: %s", err)
+					return
+				}
+			}
+		}()
+	}
+	for n := 1; n <= 20; n++ {
+		tmp := meowFile + ".tmp"
+		os.WriteFile(tmp, []byte(fmt.Sprintf(`{"chess": {"n": %d}}`, n)), 0o600)
+		os.Rename(tmp, meowFile)
+		time.Sleep(time.Millisecond)
+	}
+	wg.Wait()
+	os.WriteFile(meowFile, []byte(`{"chess": {"n": 1000}}`), 0o600)
+	if err := w.Registry().Reload(); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if n := w.Registry().Meow().ValueInt("n"); n != 1000 {
+		t.Errorf("Error: found `%d`", n)
+	}
+}
@@ -0,0 +1,178 @@
+package meow
+
+import (
+	"compress/gzip"
+	"fmt"
+	"hash/maphash"
+	"io"
+	"net/http"
+	"os"
+	"path/filepath"
+	"time"
+)
+
+// WatchURL loads the meow for an application appid from an HTTP(S) url and refreshes it in
+// the background every interval, 1m when interval is not positive. Refreshes are conditional
+// on the ETag of the last download, so an unchanged document costs a single 304 response.
+//
+// When cacheFile is not empty, every download is saved there. A later WatchURL starts from
+// the cached copy without a network round-trip and refreshes it right away in the
+// background. The cache is written on a best effort basis.
+func WatchURL(appid string, url string, cacheFile string, interval time.Duration, opts ...Option) (*Watcher, error) {
+	if appid == "" {
+		return nil, fmt.Errorf("meow identification is empty")
+	}
+	if url == "" {
+		return nil, fmt.Errorf("no meow url specified")
+	}
+	if interval <= 0 {
+		interval = time.Minute
+	}
+	src := newURLSource(appid, url, cacheFile, newOptions(opts))
+	reg, err := NewRegistry(src.load)
+	if err != nil {
+		return nil, err
+	}
+	events := make(chan struct{}, 1)
+	if src.cached {
+		events <- struct{}{}
+	}
+	return startWatcher(reg, src.o, events, func() {}, interval, nil), nil
+}
+
+// urlSource loads a meow document over HTTP. Downloads go through the incremental build of
+// fileSource, so a changed document only decodes and merges its changed layers again.
+type urlSource struct {
+	fileSource
+	url       string
+	cacheFile string
+	client    *http.Client
+
+	etag   string
+	cached bool
+}
+
+func newURLSource(appid string, url string, cacheFile string, o *options) *urlSource {
+	s := &urlSource{
+		fileSource: fileSource{appid: appid, o: o, seed: maphash.MakeSeed()},
+		url:        url,
+		cacheFile:  cacheFile,
+		client:     o.client,
+	}
+	if s.client == nil {
+		s.client = &http.Client{Timeout: 30 * time.Second}
+	}
+	return s
+}
+
+// load returns the meow of the url, or nil when the document did not change. The first
+// call returns the cached copy when there is a valid one.
+func (s *urlSource) load() (*Meow, error) {
+	if s.layers == nil && s.cacheFile != "" {
+		if meow := s.loadCache(); meow != nil {
+			return meow, nil
+		}
+	}
+
+	req, err := http.NewRequest(http.MethodGet, s.url, nil)
+	if err != nil {
+		return nil, fmt.Errorf("error at fetching meow `%s`: %s", s.url, err)
+	}
+	req.Header.Set("Accept-Encoding", "gzip")
+	if s.layers != nil && s.etag != "" {
+		req.Header.Set("If-None-Match", s.etag)
+	}
+	resp, err := s.client.Do(req)
+	if err != nil {
+		return nil, fmt.Errorf("error at fetching meow `%s`: %s", s.url, err)
+	}
+	defer resp.Body.Close()
+	if resp.StatusCode == http.StatusNotModified && s.layers != nil {
+		return nil, nil
+	}
+	if resp.StatusCode != http.StatusOK {
+		return nil, fmt.Errorf("error at fetching meow `%s`: %s", s.url, resp.Status)
+	}
+	body := resp.Body
+	if resp.Header.Get("Content-Encoding") == "gzip" {
+		gz, err := gzip.NewReader(resp.Body)
+		if err != nil {
+			return nil, fmt.Errorf("error at fetching meow `%s`: %s", s.url, err)
+		}
+		defer gz.Close()
+		body = gz
+	}
+	data, err := io.ReadAll(body)
+	if err != nil {
+		return nil, fmt.Errorf("error at fetching meow `%s`: %s", s.url, err)
+	}
+
+	etag := resp.Header.Get("ETag")
+	sum := maphash.Bytes(s.seed, data)
+	if s.layers != nil && sum == s.sum {
+		s.etag = etag
+		return nil, nil
+	}
+	merged, err := s.build(data)
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow `%s`: %s", s.url, err)
+	}
+	meow, err := newMeow(s.appid, merged, s.o)
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow `%s`: %s", s.url, err)
+	}
+	s.sum, s.etag = sum, etag
+	s.saveCache(data)
+	return meow, nil
+}
+
+// loadCache returns the meow of the cached copy, nil when there is none or it is broken.
+func (s *urlSource) loadCache() *Meow {
+	data, err := os.ReadFile(s.cacheFile)
+	if err != nil {
+		return nil
+	}
+	merged, err := s.build(data)
+	if err != nil {
+		return nil
+	}
+	meow, err := newMeow(s.appid, merged, s.o)
+	if err != nil {
+		return nil
+	}
+	s.sum = maphash.Bytes(s.seed, data)
+	if etag, err := os.ReadFile(s.cacheFile + ".etag"); err == nil {
+		s.etag = string(etag)
+	}
+	s.cached = true
+	return meow
+}
+
+// saveCache replaces the cached copy with data. The document is renamed into place, so a
+// crash never leaves a partial copy behind.
+func (s *urlSource) saveCache(data []byte) {
+	if s.cacheFile == "" {
+		return
+	}
+	if writeFile(s.cacheFile, data) == nil {
+		writeFile(s.cacheFile+".etag", []byte(s.etag))
+	}
+}
+
+func writeFile(name string, data []byte) error {
+	f, err := os.CreateTemp(filepath.Dir(name), filepath.Base(name)+".*")
+	if err != nil {
+		return err
+	}
+	_, err = f.Write(data)
+	if cerr := f.Close(); err == nil {
+		err = cerr
+	}
+	if err == nil {
+		err = os.Rename(f.Name(), name)
+	}
+	if err != nil {
+		os.Remove(f.Name())
+	}
+	return err
+}
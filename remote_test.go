@@ -0,0 +1,110 @@
+package meow
+
+import (
+	"compress/gzip"
+	"net/http"
+	"net/http/httptest"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestURLSource(t *testing.T) {
+
+	for _, opts := range [][]Option{nil, {WithArena()}} {
+		testURLSource(t, opts)
+	}
+}
+
+func testURLSource(t *testing.T, opts []Option) {
+	var mu sync.Mutex
+	doc, etag := body, `"v1"`
+	var fetches, notModified int
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		mu.Lock()
+		defer mu.Unlock()
+		fetches++
+		if r.Header.Get("If-None-Match") == etag {
+			notModified++
+			w.WriteHeader(http.StatusNotModified)
+			return
+		}
+		w.Header().Set("ETag", etag)
+		if strings.Contains(r.Header.Get("Accept-Encoding"), "gzip") {
+			w.Header().Set("Content-Encoding", "gzip")
+			gz := gzip.NewWriter(w)
+			gz.Write([]byte(doc))
+			gz.Close()
+			return
+		}
+		w.Write([]byte(doc))
+	}))
+	defer server.Close()
+
+	expected, err := LoadReader("chess", strings.NewReader(body))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	cacheFile := filepath.Join(t.TempDir(), "meow.json")
+	src := newURLSource("chess", server.URL, cacheFile, newOptions(opts))
+	meow, err := src.load()
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if !reflect.DeepEqual(meow.root(), expected.meow) {
+		t.Errorf("Error: found\n%v\nexpected\n%v", meow.root(), expected.meow)
+	}
+	if meow, err := src.load(); meow != nil || err != nil || notModified != 1 {
+		t.Errorf("Error: unchanged document reloaded: %v", err)
+	}
+
+	mu.Lock()
+	doc, etag = strings.Replace(body, `"key-test1": "branch1 general3"`, `"key-test1": "changed"`, 1), `"v2"`
+	mu.Unlock()
+	meow, err = src.load()
+	if err != nil || meow.ValueString("key-test1") != "changed" {
+		t.Fatalf("Error: changed document not reloaded: %v", err)
+	}
+
+	// A new source starts from the cache, then refreshes with a conditional request.
+	fetches = 0
+	cached := newURLSource("chess", server.URL, cacheFile, newOptions(opts))
+	meow, err = cached.load()
+	if err != nil || fetches != 0 || meow.ValueString("key-test1") != "changed" {
+		t.Fatalf("Error: cache not used: %v", err)
+	}
+	if meow, err := cached.load(); meow != nil || err != nil || fetches != 1 || notModified != 2 {
+		t.Errorf("Error: cached document reloaded: %v", err)
+	}
+
+	// The watcher refreshes the cached copy once, then polls with conditional requests that
+	// publish nothing.
+	w, err := WatchURL("chess", server.URL, cacheFile, 5*time.Millisecond, opts...)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	var published int
+	w.Registry().Subscribe(func(old, new *Meow) { published++ })
+	mu.Lock()
+	fetches, notModified = 0, 0
+	mu.Unlock()
+	time.Sleep(100 * time.Millisecond)
+	w.Close()
+	if w.Registry().Meow().ValueString("key-test1") != "changed" || w.Err() != nil {
+		t.Errorf("Error: found `%s`: %v", w.Registry().Meow().ValueString("key-test1"), w.Err())
+	}
+	mu.Lock()
+	if published != 0 || notModified < 2 || notModified != fetches {
+		t.Errorf("Error: %d publishes, %d of %d requests not modified", published, notModified, fetches)
+	}
+	mu.Unlock()
+
+	missing := httptest.NewServer(http.NotFoundHandler())
+	defer missing.Close()
+	if _, err := newURLSource("chess", missing.URL, "", newOptions(opts)).load(); err == nil {
+		t.Errorf("Error: no error for a missing document")
+	}
+}
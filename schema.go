@@ -0,0 +1,339 @@
+package meow
+
+import (
+	"encoding/json"
+	"fmt"
+	"reflect"
+	"sort"
+	"strings"
+	"time"
+)
+
+// Schema describes the values expected in a meow, see WithSchema. It is built from a
+// subset of JSON Schema with ParseSchema or from the fields of a struct with SchemaOf.
+type Schema struct {
+	root *schemaNode
+}
+
+// The types of a schema node. A node without types accepts any value.
+const (
+	schemaString = 1 << iota
+	schemaInteger
+	schemaNumber
+	schemaBoolean
+	schemaObject
+	schemaArray
+	schemaNull
+)
+
+var schemaTypes = []string{"string", "integer", "number", "boolean", "object", "array", "null"}
+
+type schemaNode struct {
+	types      int
+	duration   bool
+	properties map[string]*schemaNode
+	required   []string
+	values     *schemaNode
+	closed     bool
+	items      *schemaNode
+}
+
+// ParseSchema parses a JSON Schema. The supported keywords are type, with a name or a list
+// of names, format with the value duration for strings accepted by time.ParseDuration,
+// properties, required, additionalProperties with a schema or false, and items with a
+// schema. Other keywords are ignored.
+func ParseSchema(data []byte) (*Schema, error) {
+	var v any
+	if err := json.Unmarshal(data, &v); err != nil {
+		return nil, fmt.Errorf("invalid schema: %s", err)
+	}
+	root, err := parseSchemaNode(v, "")
+	if err != nil {
+		return nil, err
+	}
+	return &Schema{root}, nil
+}
+
+func parseSchemaNode(v any, path string) (*schemaNode, error) {
+	obj, ok := v.(map[string]any)
+	if !ok {
+		return nil, fmt.Errorf("invalid schema at `%s`: not an object", path)
+	}
+	n := new(schemaNode)
+	var types []any
+	switch t := obj["type"].(type) {
+	case nil:
+	case string:
+		types = []any{t}
+	case []any:
+		types = t
+	default:
+		return nil, fmt.Errorf("invalid schema at `%s`: invalid type", path)
+	}
+	for _, t := range types {
+		i := 0
+		for i < len(schemaTypes) && schemaTypes[i] != t {
+			i++
+		}
+		if i == len(schemaTypes) {
+			return nil, fmt.Errorf("invalid schema at `%s`: unknown type %v", path, t)
+		}
+		n.types |= 1 << i
+	}
+	n.duration = obj["format"] == "duration"
+	if props, ok := obj["properties"].(map[string]any); ok {
+		n.properties = make(map[string]*schemaNode, len(props))
+		for k, p := range props {
+			child, err := parseSchemaNode(p, bindPath(path, k))
+			if err != nil {
+				return nil, err
+			}
+			n.properties[k] = child
+		}
+	}
+	if required, ok := obj["required"].([]any); ok {
+		for _, r := range required {
+			k, ok := r.(string)
+			if !ok {
+				return nil, fmt.Errorf("invalid schema at `%s`: invalid required", path)
+			}
+			n.required = append(n.required, k)
+		}
+	}
+	switch a := obj["additionalProperties"].(type) {
+	case bool:
+		n.closed = !a
+	case map[string]any:
+		values, err := parseSchemaNode(a, bindPath(path, "*"))
+		if err != nil {
+			return nil, err
+		}
+		n.values = values
+	}
+	if items, ok := obj["items"]; ok {
+		child, err := parseSchemaNode(items, bindPath(path, "[]"))
+		if err != nil {
+			return nil, err
+		}
+		n.items = child
+	}
+	return n, nil
+}
+
+// SchemaOf returns the schema of the meows that bind to v, a struct or a pointer to a
+// struct, see Meow.Bind: every field found in the meow must be of the type of the field.
+// Missing fields and null values are accepted, like Bind does.
+func SchemaOf(v any) (*Schema, error) {
+	t := reflect.TypeOf(v)
+	if t != nil && t.Kind() == reflect.Pointer {
+		t = t.Elem()
+	}
+	if t == nil || t.Kind() != reflect.Struct {
+		return nil, fmt.Errorf("cannot build a schema of %T: not a struct", v)
+	}
+	n, err := schemaOfType(t, t.String())
+	if err != nil {
+		return nil, err
+	}
+	return &Schema{n}, nil
+}
+
+func schemaOfType(t reflect.Type, path string) (*schemaNode, error) {
+	n := &schemaNode{}
+	switch {
+	case t == durationType:
+		n.types, n.duration = schemaString, true
+	case t.Kind() == reflect.String:
+		n.types = schemaString
+	case t.Kind() == reflect.Bool:
+		n.types = schemaBoolean
+	case t.Kind() >= reflect.Int && t.Kind() <= reflect.Uintptr:
+		n.types = schemaInteger
+	case t.Kind() == reflect.Float32 || t.Kind() == reflect.Float64:
+		n.types = schemaNumber
+	case t.Kind() == reflect.Interface && t.NumMethod() == 0:
+		return n, nil
+	case t.Kind() == reflect.Slice:
+		items, err := schemaOfType(t.Elem(), path+"[]")
+		if err != nil {
+			return nil, err
+		}
+		n.types, n.items = schemaArray, items
+	case t.Kind() == reflect.Map && t.Key().Kind() == reflect.String:
+		values, err := schemaOfType(t.Elem(), path+".*")
+		if err != nil {
+			return nil, err
+		}
+		n.types, n.values = schemaObject, values
+	case t.Kind() == reflect.Struct:
+		n.types = schemaObject
+		if err := schemaOfStruct(n, t, path); err != nil {
+			return nil, err
+		}
+	default:
+		return nil, fmt.Errorf("cannot build a schema of `%s`: unsupported type %s", path, t)
+	}
+	n.types |= schemaNull
+	return n, nil
+}
+
+// schemaOfStruct adds the fields of t to n, following the keys of their tags.
+func schemaOfStruct(n *schemaNode, t reflect.Type, path string) error {
+	for _, f := range bindPlan(t) {
+		ft := t.Field(f.index)
+		if f.embedded {
+			if err := schemaOfStruct(n, ft.Type, path); err != nil {
+				return err
+			}
+			continue
+		}
+		child, err := schemaOfType(ft.Type, path+"."+ft.Name)
+		if err != nil {
+			return err
+		}
+		parent := n
+		for _, k := range f.key[:len(f.key)-1] {
+			if parent.properties == nil {
+				parent.properties = make(map[string]*schemaNode)
+			}
+			next, ok := parent.properties[k]
+			if !ok {
+				next = &schemaNode{types: schemaObject | schemaNull}
+				parent.properties[k] = next
+			}
+			parent = next
+		}
+		if parent.properties == nil {
+			parent.properties = make(map[string]*schemaNode)
+		}
+		parent.properties[f.key[len(f.key)-1]] = child
+	}
+	return nil
+}
+
+// check validates v, the value at path, and adds the typed views of the values the schema
+// fixes to table.
+func (n *schemaNode) check(v any, path []string, table map[string]any) error {
+	if n.types != 0 && !n.accepts(v) {
+		var names []string
+		for i, name := range schemaTypes {
+			if n.types&(1<<i) != 0 {
+				names = append(names, name)
+			}
+		}
+		return schemaError(path, "expected "+strings.Join(names, " or "))
+	}
+	switch v := v.(type) {
+	case map[string]any:
+		for _, k := range n.required {
+			if _, ok := v[k]; !ok {
+				return schemaError(append(path, k), "missing")
+			}
+		}
+		keys := make([]string, 0, len(v))
+		for k := range v {
+			keys = append(keys, k)
+		}
+		sort.Strings(keys)
+		for _, k := range keys {
+			child, ok := n.properties[k]
+			if !ok {
+				child = n.values
+			}
+			if child == nil {
+				if n.closed {
+					return schemaError(append(path, k), "not allowed")
+				}
+				continue
+			}
+			if err := child.check(v[k], append(path[:len(path):len(path)], k), table); err != nil {
+				return err
+			}
+		}
+		if n.values != nil && len(n.properties) == 0 {
+			storeView(table, path, n.values, v)
+		}
+	case []any:
+		if n.items == nil {
+			return nil
+		}
+		for i, e := range v {
+			if err := n.items.check(e, append(path[:len(path):len(path)], fmt.Sprintf("[%d]", i)), nil); err != nil {
+				return err
+			}
+		}
+		storeView(table, path, n.items, v)
+	}
+	return nil
+}
+
+// storeView adds to table the typed view of v, an object or an array, when elem fixes its
+// elements to strings or integers. Values inside arrays have no sequence of keys: they are
+// checked with a nil table.
+func storeView(table map[string]any, path []string, elem *schemaNode, v any) {
+	if table == nil {
+		return
+	}
+	_, object := v.(map[string]any)
+	var kind byte
+	var view any
+	switch t := elem.types &^ schemaNull; {
+	case t == schemaString && object:
+		kind, view = viewStringMap, asStringMap(v)
+	case t == schemaString:
+		kind, view = viewStringSlice, asStringSlice(v)
+	case t == schemaInteger && object:
+		kind, view = viewIntMap, asIntMap(v)
+	case t == schemaInteger:
+		kind, view = viewIntSlice, asIntSlice(v)
+	default:
+		return
+	}
+	table[string(viewKey(nil, kind, path))] = view
+}
+
+func (n *schemaNode) accepts(v any) bool {
+	switch v := v.(type) {
+	case nil:
+		return n.types&schemaNull != 0
+	case string:
+		if n.types&schemaString == 0 {
+			return false
+		}
+		if n.duration {
+			_, err := time.ParseDuration(v)
+			return err == nil
+		}
+		return true
+	case bool:
+		return n.types&schemaBoolean != 0
+	case float64, json.Number:
+		if n.types&schemaNumber != 0 {
+			return true
+		}
+		_, ok := asInteger(v)
+		return ok && n.types&schemaInteger != 0
+	case map[string]any:
+		return n.types&schemaObject != 0
+	case []any:
+		return n.types&schemaArray != 0
+	}
+	return false
+}
+
+func schemaError(path []string, msg string) error {
+	if len(path) == 0 {
+		return fmt.Errorf("meow does not match the schema: %s", msg)
+	}
+	return fmt.Errorf("meow `%s` does not match the schema: %s", strings.Join(path, "."), msg)
+}
+
+// validate checks the meow against its schema and builds its type table.
+func (s *Schema) validate(meow *Meow) error {
+	table := make(map[string]any)
+	if err := s.root.check(meow.root(), nil, table); err != nil {
+		return err
+	}
+	meow.typed = table
+	return nil
+}
@@ -0,0 +1,131 @@
+package meow
+
+import (
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+)
+
+var schemaBody = `{
+	"type": "object",
+	"required": ["string", "map-string"],
+	"properties": {
+		"string": {"type": "string"},
+		"int": {"type": "integer"},
+		"meow-score": {"type": ["integer", "null"]},
+		"map-string": {"type": "object", "additionalProperties": {"type": "string"}},
+		"slice-string": {"type": "array", "items": {"type": "string"}},
+		"slice-int": {"type": "array", "items": {"type": "integer"}},
+		"g1": {"type": "object", "properties": {"a1": {"type": "string"}}, "additionalProperties": false}
+	}
+}`
+
+func TestSchema(t *testing.T) {
+
+	s, err := ParseSchema([]byte(schemaBody))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	for _, opts := range [][]Option{{WithSchema(s)}, {WithSchema(s), WithArena()}, {WithSchema(s), WithLazy(), WithViews()}} {
+		meow, err := LoadReader("chess", strings.NewReader(body), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		if found := meow.ValueStringMap("map-string"); !reflect.DeepEqual(found, map[string]string{"a": "A", "b": "B"}) {
+			t.Errorf("Error: found `%v`", found)
+		}
+		if found := meow.ValueStringSlice("slice-string"); !reflect.DeepEqual(found, []string{"a", "b"}) {
+			t.Errorf("Error: found `%v`", found)
+		}
+		if found := meow.ValueIntSlice("slice-int"); !reflect.DeepEqual(found, []int{1, 2}) {
+			t.Errorf("Error: found `%v`", found)
+		}
+		if n := testing.AllocsPerRun(100, func() { meow.ValueStringMap("map-string") }); n != 0 {
+			t.Errorf("Error: ValueStringMap allocates %v times", n)
+		}
+		if found := meow.ValueString("string"); found != "S" {
+			t.Errorf("Error: found `%s`", found)
+		}
+	}
+}
+
+func TestSchemaMismatch(t *testing.T) {
+
+	for _, c := range []struct {
+		schema string
+		err    string
+	}{
+		{`{"properties": {"string": {"type": "integer"}}}`, "meow `string` does not match the schema: expected integer"},
+		{`{"required": ["missing"]}`, "meow `missing` does not match the schema: missing"},
+		{`{"properties": {"g1": {"properties": {"b1": {}}, "additionalProperties": false}}}`, "meow `g1.a1` does not match the schema: not allowed"},
+		{`{"properties": {"slice-string": {"items": {"type": "integer"}}}}`, "meow `slice-string.[0]` does not match the schema: expected integer"},
+		{`{"properties": {"string": {"type": "string", "format": "duration"}}}`, "meow `string` does not match the schema: expected string"},
+		{`{"type": "array"}`, "meow does not match the schema: expected array"},
+	} {
+		s, err := ParseSchema([]byte(c.schema))
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		_, err = LoadReader("chess", strings.NewReader(body), WithSchema(s))
+		if err == nil || err.Error() != c.err {
+			t.Errorf("Error: schema %s: found `%v`, expected `%s`", c.schema, err, c.err)
+		}
+	}
+}
+
+func TestSchemaOf(t *testing.T) {
+
+	type G1 struct {
+		A1 string `meow:"a1"`
+	}
+	type Chess struct {
+		String  string            `meow:"string"`
+		Int     int               `meow:"int"`
+		Strings []string          `meow:"slice-string"`
+		Map     map[string]string `meow:"map-string"`
+		G1      G1                `meow:"g1"`
+		Timeout time.Duration     `meow:"timeout"`
+	}
+	s, err := SchemaOf(&Chess{})
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	meow, err := LoadReader("chess", strings.NewReader(body), WithSchema(s))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if found := meow.ValueStringMap("map-string"); !reflect.DeepEqual(found, map[string]string{"a": "A", "b": "B"}) {
+		t.Errorf("Error: found `%v`", found)
+	}
+
+	type Wrong struct {
+		Strings []int `meow:"slice-string"`
+	}
+	if s, err = SchemaOf(Wrong{}); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if _, err = LoadReader("chess", strings.NewReader(body), WithSchema(s)); err == nil {
+		t.Errorf("Error: no error for a mismatched struct")
+	}
+	if _, err = SchemaOf(1); err == nil {
+		t.Errorf("Error: no error for a schema of an int")
+	}
+}
+
+func TestParseSchemaInvalid(t *testing.T) {
+
+	for _, schema := range []string{
+		`[`,
+		`[]`,
+		`{"type": "float"}`,
+		`{"type": 1}`,
+		`{"required": [1]}`,
+		`{"properties": {"a": 1}}`,
+		`{"items": "string"}`,
+	} {
+		if _, err := ParseSchema([]byte(schema)); err == nil {
+			t.Errorf("Error: no error for schema %s", schema)
+		}
+	}
+}
@@ -0,0 +1,136 @@
+package meow
+
+import (
+	"fmt"
+	"io"
+	"os"
+	"sort"
+	"sync"
+)
+
+// Shared is a meow document loaded once for several applications. The scored layers are
+// decoded and merged once; the meow of an application is built on first access by laying
+// its own layer over that common merge. Every meow shares the values of the common merge
+// by reference and only owns its top-level map and the values of its own layer.
+type Shared struct {
+	o      *options
+	layers []layer
+	base   map[string]any
+
+	mu    sync.Mutex
+	raw   map[string][]byte
+	meows map[string]*Meow
+}
+
+// LoadSharedFile loads a shared meow document from a given file.
+func LoadSharedFile(meowFile string, opts ...Option) (*Shared, error) {
+	if meowFile == "" {
+		return nil, fmt.Errorf("no meow file specified")
+	}
+	data, err := os.ReadFile(meowFile)
+	if err != nil {
+		return nil, fmt.Errorf("error at opening meow file `%s`: %s", meowFile, err)
+	}
+	s, err := newShared(data, newOptions(opts))
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow file `%s`: %s", meowFile, err)
+	}
+	return s, nil
+}
+
+// LoadSharedReader loads a shared meow document from a given io.Reader.
+func LoadSharedReader(reader io.Reader, opts ...Option) (*Shared, error) {
+	data, err := io.ReadAll(reader)
+	if err != nil {
+		return nil, err
+	}
+	return newShared(data, newOptions(opts))
+}
+
+func newShared(data []byte, o *options) (*Shared, error) {
+	o = o.forDocument(data)
+	spans, err := o.split(data)
+	if err != nil {
+		return nil, err
+	}
+	if err := validJSON(data, o); err != nil {
+		return nil, err
+	}
+	s := &Shared{o: o, raw: make(map[string][]byte), meows: make(map[string]*Meow)}
+	// As with json.Unmarshal, a later value of a name replaces the earlier one.
+	set := layerSet{}
+	for _, sp := range spans {
+		raw := data[sp.start:sp.end]
+		mw, scored, err := decodeSpan(raw, false, o)
+		if err != nil {
+			return nil, fmt.Errorf("does not contain a valid JSON object: %s", err)
+		}
+		set.layer(sp.key, mw, scored)
+		// Any top-level value may be the layer of an application: keep it undecoded.
+		s.raw[sp.key] = append([]byte(nil), raw...)
+	}
+	s.layers = set.layers()
+	sort.Sort(byPrecedence(s.layers))
+	s.base = mergeLayers(s.layers, o.deep)
+	return s, nil
+}
+
+// Meow returns the meow of an application appid, built on first access.
+func (s *Shared) Meow(appid string) (*Meow, error) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if meow, ok := s.meows[appid]; ok {
+		return meow, nil
+	}
+	raw, ok := s.raw[appid]
+	if !ok {
+		return nil, fmt.Errorf("does not contain `%s`", appid)
+	}
+	app, _, err := decodeSpan(raw, true, s.o)
+	if err != nil {
+		return nil, fmt.Errorf("does not contain a valid JSON object: %s", err)
+	}
+	if app.value == nil {
+		return nil, fmt.Errorf("`%s` is not a JSON object", appid)
+	}
+
+	var merged map[string]any
+	if s.scored(appid) {
+		// The application layer is also a scored layer: merge without it.
+		mews := make([]layer, 0, len(s.layers))
+		for _, mw := range s.layers {
+			if mw.name != appid {
+				mews = append(mews, mw)
+			}
+		}
+		merged = mergeLayers(append(mews, layer{name: appid, value: app.value}), s.o.deep)
+	} else {
+		merged = make(map[string]any, len(s.base)+len(app.value))
+		for k, v := range s.base {
+			merged[k] = v
+		}
+		lower := []map[string]any{s.base}
+		for k, v := range app.value {
+			if s.o.deep {
+				v = mergeValue(lower, k, v)
+			}
+			merged[k] = v
+		}
+	}
+	meow, err := newMeow(appid, merged, s.o)
+	if err != nil {
+		return nil, err
+	}
+	s.meows[appid] = meow
+	delete(s.raw, appid)
+	return meow, nil
+}
+
+func (s *Shared) scored(name string) bool {
+	for _, mw := range s.layers {
+		if mw.name == name {
+			return true
+		}
+	}
+	return false
+}
@@ -0,0 +1,64 @@
+package meow
+
+import (
+	"reflect"
+	"strings"
+	"sync"
+	"testing"
+)
+
+func TestShared(t *testing.T) {
+
+	doc := strings.Replace(body, `"chess": {`, `"go": {"key-test": "branch go", "g1": {"b1": "B"}}, "scalar": 1, "chess": {`, 1)
+	doc = strings.Replace(doc, `"general3": {`, `"general3": {"g1": {"c1": "C"}, `, 1)
+	for _, opts := range [][]Option{nil, {WithDeepMerge()}} {
+		shared, err := LoadSharedReader(strings.NewReader(doc), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		var wg sync.WaitGroup
+		for i := 0; i < 4; i++ {
+			wg.Add(1)
+			go func() {
+				defer wg.Done()
+				shared.Meow("chess")
+			}()
+		}
+		wg.Wait()
+
+		for _, appid := range []string{"chess", "go", "general1"} {
+			meow, err := shared.Meow(appid)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			expected, err := LoadReader(appid, strings.NewReader(doc), opts...)
+			if err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+			if !reflect.DeepEqual(meow.meow, expected.meow) {
+				t.Errorf("Error: %s: found\n%v\nexpected\n%v", appid, meow.meow, expected.meow)
+			}
+			if again, _ := shared.Meow(appid); again != meow {
+				t.Errorf("Error: %s built twice", appid)
+			}
+		}
+		if _, err := shared.Meow("none"); err == nil {
+			t.Errorf("Error: no error for an undefined application")
+		}
+		if _, err := shared.Meow("scalar"); err == nil {
+			t.Errorf("Error: no error for an application that is not an object")
+		}
+	}
+
+	shared, err := LoadSharedReader(strings.NewReader(`{"chess": {"a": 1}}`), WithDeepMerge())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if meow, err := shared.Meow("chess"); err != nil || meow.ValueInt("a") != 1 {
+		t.Errorf("Error: without scored layers: found `%v` `%v`", meow, err)
+	}
+
+	if _, err := LoadSharedReader(strings.NewReader(`{"a": {"meow-score": 1}, "b": x}`)); err == nil {
+		t.Errorf("Error: no error for an invalid document")
+	}
+}
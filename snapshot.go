@@ -0,0 +1,452 @@
+package meow
+
+import (
+	"bytes"
+	"encoding/binary"
+	"encoding/json"
+	"fmt"
+	"io"
+	"math"
+	"os"
+	"path/filepath"
+	"sort"
+	"unsafe"
+)
+
+// A snapshot is the merged meow of an application in a compact binary form, so that a
+// process can start without decoding JSON. All integers are little endian:
+//
+//	header   magic "MEOW", version u32, source size i64, source mtime i64 (unix ns),
+//	         options u32, appid length u32, strings length u32, node count u32,
+//	         entry count u32
+//	appid    bytes
+//	strings  all keys and string values, concatenated
+//	nodes    16 bytes each: kind u8, 3 bytes padding, a u32, b u64
+//	entries  12 bytes each: key offset u32, key length u32, node u32
+//
+// Node 0 is the merged object. Strings are a length in a and an offset in b, numbers are
+// the float64 bits in b or, decoded with WithNumbers, their text stored like a string,
+// booleans are a. Objects and arrays hold a count in a and the index
+// of their first entry in b; the entries of an object are sorted by key, array entries have
+// no key. The entries of the containers are stored in the order of their nodes, and
+// children after their parent. A snapshot records the size and modification time of its
+// source file and is stale as soon as either differs. It also records the options that
+// change the merged meow, WithDeepMerge and WithNumbers, and is only loaded with the same.
+const (
+	snapshotMagic   = "MEOW"
+	snapshotVersion = 2
+	snapshotHeader  = 44
+	snapshotNode    = 16
+	snapshotEntry   = 12
+)
+
+const (
+	snapshotDeep uint32 = 1 << iota
+	snapshotNumbers
+)
+
+// snapshotOptions returns the options of a snapshot header.
+func snapshotOptions(deep bool, numbers bool) uint32 {
+	var f uint32
+	if deep {
+		f |= snapshotDeep
+	}
+	if numbers {
+		f |= snapshotNumbers
+	}
+	return f
+}
+
+const (
+	nodeNull byte = iota
+	nodeBool
+	nodeNumber
+	nodeString
+	nodeObject
+	nodeArray
+	nodeNumberText
+)
+
+type snapshotSource struct {
+	size  int64
+	mtime int64
+}
+
+// CompileSnapshot loads the meow for an application appid from meowFile and writes it as a
+// snapshot to snapFile. The snapshot is written to a temporary file first and renamed.
+func CompileSnapshot(appid string, meowFile string, snapFile string, opts ...Option) error {
+	fi, err := os.Stat(meowFile)
+	if err != nil {
+		return fmt.Errorf("error at opening meow file `%s`: %s", meowFile, err)
+	}
+	meow, err := LoadFile(appid, meowFile, opts...)
+	if err != nil {
+		return err
+	}
+	data, err := encodeSnapshot(meow, snapshotSource{fi.Size(), fi.ModTime().UnixNano()})
+	if err != nil {
+		return err
+	}
+
+	tmp, err := os.CreateTemp(filepath.Dir(snapFile), filepath.Base(snapFile)+".*")
+	if err != nil {
+		return fmt.Errorf("error at writing snapshot `%s`: %s", snapFile, err)
+	}
+	defer os.Remove(tmp.Name())
+	if _, err := tmp.Write(data); err != nil {
+		tmp.Close()
+		return fmt.Errorf("error at writing snapshot `%s`: %s", snapFile, err)
+	}
+	if err := tmp.Close(); err != nil {
+		return fmt.Errorf("error at writing snapshot `%s`: %s", snapFile, err)
+	}
+	if err := os.Rename(tmp.Name(), snapFile); err != nil {
+		return fmt.Errorf("error at writing snapshot `%s`: %s", snapFile, err)
+	}
+	return nil
+}
+
+// WriteSnapshot writes the meow as a snapshot to w. The snapshot records the meow file the
+// meow was loaded from; without a file it is never stale.
+func (meow *Meow) WriteSnapshot(w io.Writer) error {
+	var src snapshotSource
+	if meow.meowFile != "" {
+		fi, err := os.Stat(meow.meowFile)
+		if err != nil {
+			return fmt.Errorf("error at opening meow file `%s`: %s", meow.meowFile, err)
+		}
+		src = snapshotSource{fi.Size(), fi.ModTime().UnixNano()}
+	}
+	data, err := encodeSnapshot(meow, src)
+	if err != nil {
+		return err
+	}
+	_, err = w.Write(data)
+	return err
+}
+
+// LoadSnapshot loads the meow for an application appid from snapFile, a snapshot compiled
+// from meowFile. When the snapshot is missing, stale, broken, or compiled for another
+// application or with other merge options, the meow is loaded from meowFile instead.
+//
+// The snapshot is read into a single buffer and served in place, as with WithArena: loading
+// checks its tables without decoding them. Strings read from the meow point into the
+// buffer, which is released with the last of them and the meow, so LoadSnapshot also suits
+// the loader of a Registry.
+func LoadSnapshot(appid string, meowFile string, snapFile string, opts ...Option) (*Meow, error) {
+	if meow, err := loadSnapshot(appid, meowFile, snapFile, opts); err == nil {
+		return meow, nil
+	}
+	return LoadFile(appid, meowFile, opts...)
+}
+
+func loadSnapshot(appid string, meowFile string, snapFile string, opts []Option) (*Meow, error) {
+	data, err := os.ReadFile(snapFile)
+	if err != nil {
+		return nil, err
+	}
+	return readSnapshot(appid, meowFile, snapFile, data, newOptions(opts))
+}
+
+// readSnapshot returns the meow served from the snapshot data.
+func readSnapshot(appid string, meowFile string, snapFile string, data []byte, o *options) (*Meow, error) {
+	src, a, err := decodeSnapshot(appid, data, o)
+	if err != nil {
+		return nil, err
+	}
+	if src != (snapshotSource{}) {
+		fi, err := os.Stat(meowFile)
+		if err != nil {
+			return nil, err
+		}
+		if fi.Size() != src.size || fi.ModTime().UnixNano() != src.mtime {
+			return nil, fmt.Errorf("snapshot `%s` is stale", snapFile)
+		}
+	}
+	meow, err := newArenaMeow(appid, a, o)
+	if err != nil {
+		return nil, fmt.Errorf("error at handling snapshot `%s`: %s", snapFile, err)
+	}
+	meow.meowFile = meowFile
+	return meow, nil
+}
+
+type snapshotEncoder struct {
+	strings bytes.Buffer
+	nodes   []byte
+	entries []byte
+	offsets map[string]uint32
+}
+
+func encodeSnapshot(meow *Meow, src snapshotSource) ([]byte, error) {
+	e := &snapshotEncoder{offsets: make(map[string]uint32)}
+	if err := e.value(meow.root()); err != nil {
+		return nil, err
+	}
+	if e.strings.Len() > math.MaxUint32 || len(e.nodes)/snapshotNode > math.MaxUint32 {
+		return nil, fmt.Errorf("meow too large for a snapshot")
+	}
+
+	data := make([]byte, 0, snapshotHeader+len(meow.appid)+e.strings.Len()+len(e.nodes)+len(e.entries))
+	data = append(data, snapshotMagic...)
+	data = binary.LittleEndian.AppendUint32(data, snapshotVersion)
+	data = binary.LittleEndian.AppendUint64(data, uint64(src.size))
+	data = binary.LittleEndian.AppendUint64(data, uint64(src.mtime))
+	data = binary.LittleEndian.AppendUint32(data, snapshotOptions(meow.deep, meow.numbers))
+	data = binary.LittleEndian.AppendUint32(data, uint32(len(meow.appid)))
+	data = binary.LittleEndian.AppendUint32(data, uint32(e.strings.Len()))
+	data = binary.LittleEndian.AppendUint32(data, uint32(len(e.nodes)/snapshotNode))
+	data = binary.LittleEndian.AppendUint32(data, uint32(len(e.entries)/snapshotEntry))
+	data = append(data, meow.appid...)
+	data = append(data, e.strings.Bytes()...)
+	data = append(data, e.nodes...)
+	data = append(data, e.entries...)
+	return data, nil
+}
+
+// str stores s once and returns its offset.
+func (e *snapshotEncoder) str(s string) uint32 {
+	off, ok := e.offsets[s]
+	if !ok {
+		off = uint32(e.strings.Len())
+		e.strings.WriteString(s)
+		e.offsets[s] = off
+	}
+	return off
+}
+
+func (e *snapshotEncoder) node(kind byte, a uint32, b uint64) int {
+	n := len(e.nodes) / snapshotNode
+	e.nodes = append(e.nodes, kind, 0, 0, 0)
+	e.nodes = binary.LittleEndian.AppendUint32(e.nodes, a)
+	e.nodes = binary.LittleEndian.AppendUint64(e.nodes, b)
+	return n
+}
+
+func (e *snapshotEncoder) value(v any) error {
+	switch v := v.(type) {
+	case *lazyValue:
+		return e.value(v.get())
+	case nil:
+		e.node(nodeNull, 0, 0)
+	case bool:
+		a := uint32(0)
+		if v {
+			a = 1
+		}
+		e.node(nodeBool, a, 0)
+	case float64:
+		e.node(nodeNumber, 0, math.Float64bits(v))
+	case json.Number:
+		e.node(nodeNumberText, uint32(len(v)), uint64(e.str(string(v))))
+	case string:
+		e.node(nodeString, uint32(len(v)), uint64(e.str(v)))
+	case map[string]any:
+		keys := make([]string, 0, len(v))
+		for k := range v {
+			keys = append(keys, k)
+		}
+		sort.Strings(keys)
+		return e.children(nodeObject, keys, func(i int) any { return v[keys[i]] }, len(v))
+	case []any:
+		return e.children(nodeArray, nil, func(i int) any { return v[i] }, len(v))
+	default:
+		return fmt.Errorf("cannot store a value of type %T in a snapshot", v)
+	}
+	return nil
+}
+
+// children stores a container node and reserves its contiguous block of entries before
+// storing the children themselves.
+func (e *snapshotEncoder) children(kind byte, keys []string, child func(int) any, count int) error {
+	first := len(e.entries) / snapshotEntry
+	e.node(kind, uint32(count), uint64(first))
+	e.entries = append(e.entries, make([]byte, count*snapshotEntry)...)
+	for i := 0; i < count; i++ {
+		entry := e.entries[(first+i)*snapshotEntry:]
+		if keys != nil {
+			binary.LittleEndian.PutUint32(entry, e.str(keys[i]))
+			binary.LittleEndian.PutUint32(entry[4:], uint32(len(keys[i])))
+		}
+		binary.LittleEndian.PutUint32(entry[8:], uint32(len(e.nodes)/snapshotNode))
+		if err := e.value(child(i)); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+type snapshotDecoder struct {
+	strings string
+	nodes   []byte
+	entries []byte
+}
+
+// decodeSnapshot checks a snapshot loaded with the options o and returns an arena over its
+// tables. The arena refers to data, which must not change afterwards.
+func decodeSnapshot(appid string, data []byte, o *options) (snapshotSource, *arena, error) {
+	var src snapshotSource
+	if len(data) < snapshotHeader || string(data[:4]) != snapshotMagic {
+		return src, nil, fmt.Errorf("not a meow snapshot")
+	}
+	le := binary.LittleEndian
+	if v := le.Uint32(data[4:]); v != snapshotVersion {
+		return src, nil, fmt.Errorf("unsupported snapshot version %d", v)
+	}
+	src.size = int64(le.Uint64(data[8:]))
+	src.mtime = int64(le.Uint64(data[16:]))
+	sizes := []uint64{
+		uint64(le.Uint32(data[28:])),
+		uint64(le.Uint32(data[32:])),
+		uint64(le.Uint32(data[36:])) * snapshotNode,
+		uint64(le.Uint32(data[40:])) * snapshotEntry,
+	}
+	if snapshotHeader+sizes[0]+sizes[1]+sizes[2]+sizes[3] != uint64(len(data)) {
+		return src, nil, fmt.Errorf("truncated snapshot")
+	}
+	off := uint64(snapshotHeader)
+	part := func(size uint64) []byte {
+		p := data[off : off+size]
+		off += size
+		return p
+	}
+	if string(part(sizes[0])) != appid {
+		return src, nil, fmt.Errorf("snapshot is not compiled for `%s`", appid)
+	}
+	if f := le.Uint32(data[24:]); f != snapshotOptions(o.deep, o.numbers) {
+		return src, nil, fmt.Errorf("snapshot is compiled with other options: deep merge %t, numbers %t",
+			f&snapshotDeep != 0, f&snapshotNumbers != 0)
+	}
+	a := &arena{snapshotDecoder{strings: bytesString(part(sizes[1])), nodes: part(sizes[2]), entries: part(sizes[3])}}
+	if err := a.check(); err != nil {
+		return src, nil, err
+	}
+	return src, a, nil
+}
+
+// bytesString returns p as a string without copying it.
+func bytesString(p []byte) string {
+	if len(p) == 0 {
+		return ""
+	}
+	return unsafe.String(&p[0], len(p))
+}
+
+// check verifies the tables of a snapshot, so that a broken snapshot is rejected instead of
+// read out of bounds later. It reads every node and entry once and allocates nothing.
+func (d *snapshotDecoder) check() error {
+	le := binary.LittleEndian
+	nodes, entries := len(d.nodes)/snapshotNode, len(d.entries)/snapshotEntry
+	if nodes == 0 || d.nodes[0] != nodeObject {
+		return fmt.Errorf("broken snapshot")
+	}
+	next := 0
+	for n := 0; n < nodes; n++ {
+		node := d.nodes[n*snapshotNode:]
+		a := le.Uint32(node[4:])
+		b := le.Uint64(node[8:])
+		switch node[0] {
+		case nodeNull, nodeBool, nodeNumber:
+		case nodeString, nodeNumberText:
+			if _, err := d.str(b, a); err != nil {
+				return err
+			}
+		case nodeObject, nodeArray:
+			if b != uint64(next) || uint64(a) > uint64(entries-next) {
+				return fmt.Errorf("broken snapshot")
+			}
+			var prev string
+			for i := next; i < next+int(a); i++ {
+				entry := d.entries[i*snapshotEntry:]
+				// Children are always stored after their parent, which rules out cycles.
+				if child := int(le.Uint32(entry[8:])); child <= n || child >= nodes {
+					return fmt.Errorf("broken snapshot")
+				}
+				if node[0] == nodeArray {
+					continue
+				}
+				k, err := d.str(uint64(le.Uint32(entry)), le.Uint32(entry[4:]))
+				if err != nil {
+					return err
+				}
+				if i > next && k <= prev {
+					return fmt.Errorf("broken snapshot")
+				}
+				prev = k
+			}
+			next += int(a)
+		default:
+			return fmt.Errorf("broken snapshot")
+		}
+	}
+	if next != entries {
+		return fmt.Errorf("broken snapshot")
+	}
+	return nil
+}
+
+func (d *snapshotDecoder) str(off uint64, n uint32) (string, error) {
+	if off > uint64(len(d.strings)) || uint64(n) > uint64(len(d.strings))-off {
+		return "", fmt.Errorf("broken snapshot")
+	}
+	return d.strings[off : off+uint64(n)], nil
+}
+
+func (d *snapshotDecoder) value(n int) (any, error) {
+	if (n+1)*snapshotNode > len(d.nodes) {
+		return nil, fmt.Errorf("broken snapshot")
+	}
+	node := d.nodes[n*snapshotNode:]
+	a := binary.LittleEndian.Uint32(node[4:])
+	b := binary.LittleEndian.Uint64(node[8:])
+	switch node[0] {
+	case nodeNull:
+		return nil, nil
+	case nodeBool:
+		return a != 0, nil
+	case nodeNumber:
+		return math.Float64frombits(b), nil
+	case nodeString:
+		return d.str(b, a)
+	case nodeNumberText:
+		s, err := d.str(b, a)
+		return json.Number(s), err
+	case nodeObject, nodeArray:
+		if count := uint64(len(d.entries) / snapshotEntry); b > count || uint64(a) > count-b {
+			return nil, fmt.Errorf("broken snapshot")
+		}
+		var m map[string]any
+		var s []any
+		if node[0] == nodeObject {
+			m = make(map[string]any, a)
+		} else {
+			s = make([]any, a)
+		}
+		for i := uint64(0); i < uint64(a); i++ {
+			entry := d.entries[(b+i)*snapshotEntry:]
+			child := int(binary.LittleEndian.Uint32(entry[8:]))
+			// Children are always stored after their parent, which rules out cycles.
+			if child <= n {
+				return nil, fmt.Errorf("broken snapshot")
+			}
+			v, err := d.value(child)
+			if err != nil {
+				return nil, err
+			}
+			if node[0] == nodeArray {
+				s[i] = v
+				continue
+			}
+			k, err := d.str(uint64(binary.LittleEndian.Uint32(entry)), binary.LittleEndian.Uint32(entry[4:]))
+			if err != nil {
+				return nil, err
+			}
+			m[k] = v
+		}
+		if node[0] == nodeArray {
+			return s, nil
+		}
+		return m, nil
+	}
+	return nil, fmt.Errorf("broken snapshot")
+}
@@ -0,0 +1,98 @@
+package meow
+
+import (
+	"bytes"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestSnapshot(t *testing.T) {
+
+	dir := t.TempDir()
+	meowFile := filepath.Join(dir, "meow.json")
+	snapFile := filepath.Join(dir, "meow.snap")
+	doc := strings.Replace(body, `"int": 1,`, `"int": 1, "null": null, "bool": true, "float": 1.5, "empty": {}, "nested": [[], [{"x": "y"}]],`, 1)
+	if err := os.WriteFile(meowFile, []byte(doc), 0o600); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	expected, err := LoadFile("chess", meowFile)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+
+	if err := CompileSnapshot("chess", meowFile, snapFile); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	meow, err := loadSnapshot("chess", meowFile, snapFile, nil)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if meow.arena == nil || meow.meow != nil {
+		t.Errorf("Error: snapshot not served from its tables")
+	}
+	if !reflect.DeepEqual(meow.root(), expected.meow) {
+		t.Errorf("Error: found\n%v\nexpected\n%v", meow.root(), expected.meow)
+	}
+	if found := meow.ValueString("string"); found != expected.ValueString("string") {
+		t.Errorf("Error: found %q", found)
+	}
+
+	var buf bytes.Buffer
+	if err := meow.WriteSnapshot(&buf); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if data, _ := os.ReadFile(snapFile); !bytes.Equal(buf.Bytes(), data) {
+		t.Errorf("Error: snapshots differ")
+	}
+	data := buf.Bytes()
+	o := newOptions(nil)
+	for i := 0; i < len(data); i++ {
+		broken := append([]byte(nil), data...)
+		broken[i] ^= 0xff
+		if _, a, err := decodeSnapshot("chess", broken, o); err == nil {
+			// A snapshot that passes the checks must be safe to read.
+			for n := 0; n < len(a.nodes)/snapshotNode; n++ {
+				a.scalar(n)
+				a.child(n, "int")
+			}
+			a.get(0)
+		}
+		if _, _, err := decodeSnapshot("chess", data[:i], o); err == nil {
+			t.Errorf("Error: truncated snapshot loaded")
+		}
+	}
+	if _, _, err := decodeSnapshot("other", data, o); err == nil {
+		t.Errorf("Error: snapshot loaded for another application")
+	}
+
+	if err := CompileSnapshot("chess", meowFile, snapFile, WithDeepMerge()); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if _, err := loadSnapshot("chess", meowFile, snapFile, nil); err == nil {
+		t.Errorf("Error: snapshot with deep merge loaded without it")
+	}
+	if _, err := loadSnapshot("chess", meowFile, snapFile, []Option{WithDeepMerge(), WithNumbers()}); err == nil {
+		t.Errorf("Error: snapshot without numbers loaded with them")
+	}
+	if _, err := loadSnapshot("chess", meowFile, snapFile, []Option{WithDeepMerge()}); err != nil {
+		t.Errorf("Error: %s", err)
+	}
+
+	os.WriteFile(meowFile, []byte(`{"chess": {"int": 2}}`), 0o600)
+	os.Chtimes(meowFile, time.Now(), time.Now().Add(time.Hour))
+	if _, err := loadSnapshot("chess", meowFile, snapFile, nil); err == nil {
+		t.Errorf("Error: stale snapshot loaded")
+	}
+	meow, err = LoadSnapshot("chess", meowFile, snapFile)
+	if err != nil || meow.ValueInt("int") != 2 {
+		t.Errorf("Error: no fallback to the meow file: %v", err)
+	}
+	meow, err = LoadSnapshot("chess", meowFile, filepath.Join(dir, "none.snap"))
+	if err != nil || meow.ValueInt("int") != 2 {
+		t.Errorf("Error: no fallback to the meow file: %v", err)
+	}
+}
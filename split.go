@@ -0,0 +1,248 @@
+package meow
+
+import (
+	"bytes"
+	"encoding/json"
+	"fmt"
+)
+
+// span is the byte range of the value of a top-level key of a meow document.
+type span struct {
+	key        string
+	start, end int
+}
+
+// splitDocument returns the spans of the top-level values of a document, in document
+// order. It only checks the structure of the top-level object; the values themselves are
+// validated when they are decoded.
+func splitDocument(data []byte) ([]span, error) {
+	i := skipSpace(data, 0)
+	if i == len(data) {
+		return nil, fmt.Errorf("empty meow")
+	}
+	if data[i] != '{' {
+		return nil, fmt.Errorf("does not contain a valid JSON object")
+	}
+	var spans []span
+	i = skipSpace(data, i+1)
+	if i < len(data) && data[i] == '}' {
+		i++
+	} else {
+		for {
+			if i == len(data) || data[i] != '"' {
+				return nil, fmt.Errorf("does not contain a valid JSON object: offset %d", i)
+			}
+			e, err := scanValue(data, i)
+			if err != nil {
+				return nil, err
+			}
+			key, err := unquote(data[i:e])
+			if err != nil {
+				return nil, err
+			}
+			i = skipSpace(data, e)
+			if i == len(data) || data[i] != ':' {
+				return nil, fmt.Errorf("does not contain a valid JSON object: offset %d", i)
+			}
+			i = skipSpace(data, i+1)
+			e, err = scanValue(data, i)
+			if err != nil {
+				return nil, err
+			}
+			spans = append(spans, span{key, i, e})
+			i = skipSpace(data, e)
+			if i < len(data) && data[i] == ',' {
+				i = skipSpace(data, i+1)
+				continue
+			}
+			if i < len(data) && data[i] == '}' {
+				i++
+				break
+			}
+			return nil, fmt.Errorf("does not contain a valid JSON object: offset %d", i)
+		}
+	}
+	if skipSpace(data, i) != len(data) {
+		return nil, fmt.Errorf("does not contain a valid JSON object: trailing data")
+	}
+	return spans, nil
+}
+
+// scanValue returns the offset just after the JSON value starting at data[i].
+func scanValue(data []byte, i int) (int, error) {
+	if i == len(data) {
+		return 0, fmt.Errorf("does not contain a valid JSON object: unexpected end")
+	}
+	switch data[i] {
+	case '"':
+		for j := i + 1; j < len(data); j++ {
+			switch data[j] {
+			case '\\':
+				j++
+			case '"':
+				return j + 1, nil
+			}
+		}
+	case '{', '[':
+		depth := 0
+		for j := i; j < len(data); j++ {
+			switch data[j] {
+			case '"':
+				e, err := scanValue(data, j)
+				if err != nil {
+					return 0, err
+				}
+				j = e - 1
+			case '{', '[':
+				depth++
+			case '}', ']':
+				depth--
+				if depth == 0 {
+					return j + 1, nil
+				}
+			}
+		}
+	default:
+		j := i
+		for j < len(data) && bytes.IndexByte([]byte(",}] \t\r\n"), data[j]) < 0 {
+			j++
+		}
+		if j > i {
+			return j, nil
+		}
+	}
+	return 0, fmt.Errorf("does not contain a valid JSON object: offset %d", i)
+}
+
+func skipSpace(data []byte, i int) int {
+	for i < len(data) {
+		switch data[i] {
+		case ' ', '\t', '\r', '\n':
+			i++
+		default:
+			return i
+		}
+	}
+	return i
+}
+
+// unquote decodes a JSON string, without allocating more than the result when it holds
+// no escape sequence.
+func unquote(s []byte) (string, error) {
+	if bytes.IndexByte(s, '\\') < 0 {
+		return string(s[1 : len(s)-1]), nil
+	}
+	var v string
+	err := json.Unmarshal(s, &v)
+	return v, err
+}
+
+// readSpans decodes the layers of a document held in memory and returns them in merge
+// order, see readLayers. The values are decoded in place, without buffering the document,
+// and on several goroutines with WithParallel.
+func readSpans(appid string, data []byte, o *options) ([]layer, error) {
+	o = o.forDocument(data)
+	spans, err := o.split(data)
+	if err != nil {
+		return nil, err
+	}
+	if err := validJSON(data, o); err != nil {
+		return nil, err
+	}
+	var decoded []decodedSpan
+	if o.workers > 1 {
+		decoded = decodeParallel(appid, data, spans, o)
+	}
+	set := layerSet{appid: appid, timer: o.timer}
+	for i, sp := range spans {
+		var d decodedSpan
+		if decoded != nil {
+			d = decoded[i]
+		} else {
+			d = decodeTimed(appid, data, sp, o)
+		}
+		if d.err != nil {
+			return nil, fmt.Errorf("does not contain a valid JSON object: %s", d.err)
+		}
+		if err := set.add(sp.key, d.layer, d.scored); err != nil {
+			return nil, err
+		}
+	}
+	return set.ordered()
+}
+
+// decodeTimed decodes a span in the parse phase of the load, see loadTimer.parse.
+func decodeTimed(appid string, data []byte, sp span, o *options) decodedSpan {
+	var d decodedSpan
+	raw := data[sp.start:sp.end]
+	d.layer, d.scored, d.err = o.timer.parse(sp.key, func() (layer, bool, error) { return decodeSpan(raw, sp.key == appid, o) })
+	if d.layer.report != nil {
+		d.layer.report.Bytes = int64(len(raw))
+	}
+	return d
+}
+
+// decodeSpan decodes a top-level value held in memory, see decodeLayer. The members of an
+// object are scanned for a `meow-score` first, so unscored layers never get decoded.
+func decodeSpan(raw []byte, all bool, o *options) (layer, bool, error) {
+	var mw layer
+	if !o.object(raw) {
+		return mw, false, nil
+	}
+	var members []span
+	if !all || o.lazy {
+		var err error
+		if members, err = o.split(raw); err != nil {
+			return mw, false, err
+		}
+	}
+	if !all {
+		scored := false
+		for _, m := range members {
+			if m.key != "meow-score" {
+				continue
+			}
+			score, err := o.decode(raw[m.start:m.end])
+			if err != nil {
+				return mw, false, err
+			}
+			_, scored = numberOf(score)
+		}
+		if !scored {
+			return mw, false, nil
+		}
+	}
+	if o.lazy {
+		mw.value = make(map[string]any, len(members))
+		for _, m := range members {
+			mw.value[m.key] = newLazy(raw[m.start:m.end], o)
+		}
+		if lv, ok := mw.value["meow-score"].(*lazyValue); ok {
+			mw.value["meow-score"] = lv.get()
+		}
+	} else {
+		v, err := o.decode(raw)
+		if err != nil {
+			return mw, false, err
+		}
+		mw.value, _ = v.(map[string]any)
+	}
+	if mw.value == nil {
+		mw.value = make(map[string]any)
+	}
+	score, scored := numberOf(mw.value["meow-score"])
+	mw.score = int(score)
+	return mw, scored, nil
+}
+
+// validJSON checks the syntax of a whole document, including the values that are skipped.
+func validJSON(data []byte, o *options) error {
+	valid := json.Valid
+	if o.decoder != nil {
+		valid = o.decoder.Valid
+	}
+	if !valid(data) {
+		return fmt.Errorf("does not contain a valid JSON object")
+	}
+	return nil
+}
@@ -0,0 +1,32 @@
+package meow
+
+import (
+	"strings"
+	"testing"
+)
+
+func TestSplitDocument(t *testing.T) {
+
+	doc := ` { "a" : {"x": "}\"{", "y": [1, {"z": []}]}, "bA":1 ,"c":"s" , "d": [] } `
+	spans, err := splitDocument([]byte(doc))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	var found []string
+	for _, sp := range spans {
+		found = append(found, sp.key+"="+doc[sp.start:sp.end])
+	}
+	expected := `a={"x": "}\"{", "y": [1, {"z": []}]}|bA=1|c="s"|d=[]`
+	if strings.Join(found, "|") != expected {
+		t.Errorf("Error: found `%s`", strings.Join(found, "|"))
+	}
+
+	for _, doc := range []string{"", " ", "[]", `{"a"}`, `{"a": 1,}`, `{"a": "1}`, `{"a": {"b": 1}`, `{} x`, `{"a" 1}`} {
+		if _, err := splitDocument([]byte(doc)); err == nil {
+			t.Errorf("Error: no error for `%s`", doc)
+		}
+	}
+	if spans, err := splitDocument([]byte(" {} ")); err != nil || len(spans) != 0 {
+		t.Errorf("Error: found %v, %v for an empty object", spans, err)
+	}
+}
@@ -0,0 +1,628 @@
+package meow
+
+import (
+	"bytes"
+	"encoding/json"
+	"fmt"
+	"hash/crc32"
+	"hash/maphash"
+	"math/rand"
+	"net/http"
+	"net/http/httptest"
+	"os"
+	"path/filepath"
+	"reflect"
+	"sort"
+	"sync"
+	"sync/atomic"
+	"testing"
+	"time"
+)
+
+// randomRegistry builds a registry for the application "app" from r: a few layers with
+// colliding scores, unscored layers, a non-object top-level value, and objects nested a few
+// levels down. Keys are drawn from a small alphabet so that the layers override each other.
+func randomRegistry(r *rand.Rand) map[string]any {
+	doc := make(map[string]any)
+	for l := r.Intn(8); l >= 0; l-- {
+		obj := randomObject(r, 3)
+		switch r.Intn(6) {
+		case 0:
+		case 1:
+			obj["meow-score"] = "high"
+		case 2:
+			obj["meow-score"] = float64(r.Intn(4)) + 0.5
+		default:
+			obj["meow-score"] = float64(r.Intn(4))
+		}
+		doc[fmt.Sprintf("l%d", r.Intn(10))] = obj
+	}
+	if r.Intn(4) == 0 {
+		doc["l9"] = randomValue(r, 0)
+	}
+	doc["app"] = randomObject(r, 3)
+	return doc
+}
+
+var stressAlphabet = []string{"a", "b", "c", "d", "e", "meow-score"}
+
+func randomObject(r *rand.Rand, depth int) map[string]any {
+	obj := make(map[string]any)
+	for n := r.Intn(6); n > 0; n-- {
+		obj[stressAlphabet[r.Intn(len(stressAlphabet)-1)]] = randomValue(r, depth-1)
+	}
+	return obj
+}
+
+func randomValue(r *rand.Rand, depth int) any {
+	switch r.Intn(10) {
+	case 0:
+		return nil
+	case 1:
+		return r.Intn(2) == 0
+	case 2:
+		return float64(r.Intn(2000) - 1000)
+	case 3:
+		return float64(r.Intn(100)) + 0.25
+	case 4:
+		return []string{"1s", "12", "x", ""}[r.Intn(4)]
+	case 5:
+		a := make([]any, r.Intn(4))
+		for i := range a {
+			a[i] = randomValue(r, 0)
+		}
+		return a
+	}
+	if depth > 0 {
+		return randomObject(r, depth)
+	}
+	return fmt.Sprintf("v%d", r.Intn(5))
+}
+
+// stressConfig is a way of loading a meow that must read exactly like LoadReader.
+type stressConfig struct {
+	name string
+	opts []Option
+	load func(t testing.TB, doc any, data []byte, opts []Option) (*Meow, error)
+}
+
+func loadJSON(t testing.TB, doc any, data []byte, opts []Option) (*Meow, error) {
+	return LoadReader("app", bytes.NewReader(data), opts...)
+}
+
+var stressConfigs = []stressConfig{
+	{"stream", nil, loadJSON},
+	{"index", []Option{WithIndex()}, loadJSON},
+	{"views", []Option{WithIndex(), WithViews()}, loadJSON},
+	{"lazy", []Option{WithLazy()}, loadJSON},
+	{"parallel", []Option{WithParallel(4)}, loadJSON},
+	{"fast", []Option{WithDecoder(FastDecoder{})}, loadJSON},
+	{"lazy-fast", []Option{WithLazy(), WithDecoder(FastDecoder{})}, loadJSON},
+	{"arena", []Option{WithArena()}, loadJSON},
+	{"overlay", []Option{WithOverlay(NewOverlay())}, loadJSON},
+	{"arena-overlay", []Option{WithArena(), WithOverlay(NewOverlay())}, loadJSON},
+	{"msgpack", nil, func(t testing.TB, doc any, data []byte, opts []Option) (*Meow, error) {
+		return LoadReader("app", bytes.NewReader(encodeMsgpack(nil, doc)), opts...)
+	}},
+	{"cbor-lazy", []Option{WithLazy()}, func(t testing.TB, doc any, data []byte, opts []Option) (*Meow, error) {
+		return LoadReader("app", bytes.NewReader(encodeCBOR(nil, doc)), opts...)
+	}},
+	{"shared", nil, func(t testing.TB, doc any, data []byte, opts []Option) (*Meow, error) {
+		s, err := LoadSharedReader(bytes.NewReader(data), opts...)
+		if err != nil {
+			return nil, err
+		}
+		return s.Meow("app")
+	}},
+	{"snapshot", nil, func(t testing.TB, doc any, data []byte, opts []Option) (*Meow, error) {
+		meow, err := LoadReader("app", bytes.NewReader(data), opts...)
+		if err != nil {
+			return nil, err
+		}
+		snap, err := encodeSnapshot(meow, snapshotSource{})
+		if err != nil {
+			return nil, err
+		}
+		o := newOptions(opts)
+		_, a, err := decodeSnapshot("app", snap, o)
+		if err != nil {
+			return nil, err
+		}
+		return newArenaMeow("app", a, o)
+	}},
+	{"files", nil, func(t testing.TB, doc any, data []byte, opts []Option) (*Meow, error) {
+		dir := t.TempDir()
+		parts := []map[string]any{{}, {}}
+		for k, v := range doc.(map[string]any) {
+			parts[len(k)%2][k] = v
+		}
+		for i, part := range parts {
+			data, _ := json.Marshal(part)
+			if err := os.WriteFile(filepath.Join(dir, fmt.Sprintf("%d.json", i)), data, 0o600); err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+		}
+		return LoadFiles("app", []string{filepath.Join(dir, "*.json")}, opts...)
+	}},
+}
+
+// stressSemantics are the options changing what a meow reads: every configuration is
+// checked against LoadReader with the same semantic options.
+var stressSemantics = []struct {
+	name string
+	opts []Option
+}{{"", nil}, {"deep", []Option{WithDeepMerge()}}, {"numbers", []Option{WithNumbers()}}}
+
+// stressPaths returns the paths of every object member of v, and paths that are not defined.
+func stressPaths(v any, prefix []string, paths [][]string) [][]string {
+	paths = append(paths, append(prefix[:len(prefix):len(prefix)], "zz"))
+	m, ok := v.(map[string]any)
+	if !ok {
+		return paths
+	}
+	keys := make([]string, 0, len(m))
+	for k := range m {
+		keys = append(keys, k)
+	}
+	sort.Strings(keys)
+	for _, k := range keys {
+		p := append(prefix[:len(prefix):len(prefix)], k)
+		paths = stressPaths(m[k], p, append(paths, p))
+	}
+	return paths
+}
+
+// checkReads compares every accessor of meow with those of expected at the given paths.
+func checkReads(t testing.TB, name string, meow, expected *Meow, paths [][]string) {
+	t.Helper()
+	check := func(p []string, what string, found, want any) {
+		t.Helper()
+		if !reflect.DeepEqual(found, want) {
+			t.Fatalf("Error: %s: %s%v: found `%#v`, expected `%#v`", name, what, p, found, want)
+		}
+	}
+	check(nil, "Value", meow.Value(), expected.Value())
+	check(nil, "Exists", meow.Exists(), expected.Exists())
+	batch := CompileBatch(paths...)
+	values, want := make([]any, batch.Len()), make([]any, batch.Len())
+	check(nil, "Read", meow.Read(batch, values), expected.Read(batch, want))
+	check(nil, "Read", values, want)
+	for _, p := range paths {
+		check(p, "Value", meow.Value(p...), expected.Value(p...))
+		check(p, "Exists", meow.Exists(p...), expected.Exists(p...))
+		check(p, "ValueString", meow.ValueString(p...), expected.ValueString(p...))
+		check(p, "ValueInt", meow.ValueInt(p...), expected.ValueInt(p...))
+		check(p, "ValueStringMap", meow.ValueStringMap(p...), expected.ValueStringMap(p...))
+		check(p, "ValueIntSlice", meow.ValueIntSlice(p...), expected.ValueIntSlice(p...))
+		check(p, "Compile", meow.Compile(p...).Value(), expected.Value(p...))
+		i, iok := Lookup[int](meow, p...)
+		ei, eiok := Lookup[int](expected, p...)
+		check(p, "Lookup[int]", []any{i, iok}, []any{ei, eiok})
+		d, dok := Lookup[time.Duration](meow, p...)
+		ed, edok := Lookup[time.Duration](expected, p...)
+		check(p, "Lookup[Duration]", []any{d, dok}, []any{ed, edok})
+		f, fok := Lookup[float64](meow, p...)
+		ef, efok := Lookup[float64](expected, p...)
+		check(p, "Lookup[float64]", []any{f, fok}, []any{ef, efok})
+		check(p, "Range", rangeAll(meow, p), rangeAll(expected, p))
+	}
+}
+
+// rangeAll returns the members of the object at prefix read by Range, two at a time.
+func rangeAll(meow *Meow, prefix []string) []any {
+	var members []any
+	token := ""
+	for {
+		n := 0
+		next, err := meow.Range(prefix, token, func(key string, value any) bool {
+			members = append(members, key, value)
+			n++
+			return n < 2
+		})
+		if err != nil {
+			return append(members, err.Error())
+		}
+		if next == "" {
+			return members
+		}
+		token = next
+	}
+}
+
+// checkConfigs loads a registry with every configuration and compares the reads with those
+// of LoadReader.
+func checkConfigs(t testing.TB, doc map[string]any) {
+	t.Helper()
+	data, err := json.Marshal(doc)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	for _, sem := range stressSemantics {
+		expected, err := LoadReader("app", bytes.NewReader(data), sem.opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		paths := stressPaths(expected.Value(), nil, nil)
+		for _, c := range stressConfigs {
+			name := c.name + "/" + sem.name
+			meow, err := c.load(t, doc, data, append(append([]Option(nil), sem.opts...), c.opts...))
+			if err != nil {
+				t.Fatalf("Error: %s: %s\n%s", name, err, data)
+			}
+			checkReads(t, fmt.Sprintf("%s %s", name, data), meow, expected, paths)
+			if d := Diff(expected, meow); len(d) != 0 {
+				t.Fatalf("Error: %s: Diff found %v\n%s", name, d, data)
+			}
+		}
+	}
+}
+
+func TestStressRandom(t *testing.T) {
+
+	n := 200
+	if testing.Short() {
+		n = 20
+	}
+	for seed := int64(0); seed < int64(n); seed++ {
+		checkConfigs(t, randomRegistry(rand.New(rand.NewSource(seed))))
+	}
+}
+
+// stressSource is an incremental source of a watcher. open returns the loader of a
+// registry and a function that replaces the document the loader reads.
+type stressSource struct {
+	name string
+	opts []Option
+	open func(t testing.TB, o *options) (load func() (*Meow, error), update func(doc map[string]any, data []byte))
+}
+
+func openFileSource(t testing.TB, o *options) (func() (*Meow, error), func(map[string]any, []byte)) {
+	src := &fileSource{appid: "app", meowFile: filepath.Join(t.TempDir(), "meow.json"), o: o, seed: maphash.MakeSeed()}
+	return src.load, func(doc map[string]any, data []byte) {
+		if err := os.WriteFile(src.meowFile, data, 0o600); err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		// As an inotify event would, as the rewrite may keep the size and modification time.
+		src.notify()
+	}
+}
+
+func openFilesSource(t testing.TB, o *options) (func() (*Meow, error), func(map[string]any, []byte)) {
+	dir := t.TempDir()
+	src, err := newFilesSource("app", []string{filepath.Join(dir, "*.json")}, o)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	return src.load, func(doc map[string]any, data []byte) {
+		parts := []map[string]any{{}, {}}
+		for k, v := range doc {
+			parts[len(k)%2][k] = v
+		}
+		for i, part := range parts {
+			data, _ := json.Marshal(part)
+			if err := os.WriteFile(filepath.Join(dir, fmt.Sprintf("%d.json", i)), data, 0o600); err != nil {
+				t.Fatalf("Error: %s", err)
+			}
+		}
+		src.notify()
+	}
+}
+
+// openURLSource serves the document with an ETag of its checksum, so that an unchanged
+// document is answered with a 304.
+func openURLSource(cache bool) func(t testing.TB, o *options) (func() (*Meow, error), func(map[string]any, []byte)) {
+	return func(t testing.TB, o *options) (func() (*Meow, error), func(map[string]any, []byte)) {
+		var mu sync.Mutex
+		var doc []byte
+		server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+			mu.Lock()
+			defer mu.Unlock()
+			etag := fmt.Sprintf(`"%08x"`, crc32.ChecksumIEEE(doc))
+			if r.Header.Get("If-None-Match") == etag {
+				w.WriteHeader(http.StatusNotModified)
+				return
+			}
+			w.Header().Set("ETag", etag)
+			w.Write(doc)
+		}))
+		t.Cleanup(server.Close)
+		cacheFile := ""
+		if cache {
+			cacheFile = filepath.Join(t.TempDir(), "meow.json")
+		}
+		src := newURLSource("app", server.URL, cacheFile, o)
+		return src.load, func(_ map[string]any, data []byte) {
+			mu.Lock()
+			doc = data
+			mu.Unlock()
+		}
+	}
+}
+
+var stressSources = []stressSource{
+	{"watch-file", nil, openFileSource},
+	{"watch-file-arena", []Option{WithArena()}, openFileSource},
+	{"watch-files", nil, openFilesSource},
+	{"watch-files-arena", []Option{WithArena()}, openFilesSource},
+	{"watch-url", nil, openURLSource(false)},
+	{"watch-url-arena", []Option{WithArena()}, openURLSource(false)},
+	{"watch-url-cache", nil, openURLSource(true)},
+	{"watch-url-cache-arena", []Option{WithArena()}, openURLSource(true)},
+}
+
+// stressEdit changes a few top-level values of doc, or none, and sometimes breaks it.
+func stressEdit(r *rand.Rand, doc map[string]any) {
+	switch r.Intn(6) {
+	case 0:
+	case 1:
+		delete(doc, fmt.Sprintf("l%d", r.Intn(10)))
+	case 2:
+		doc["app"] = randomObject(r, 3)
+	case 3:
+		doc["app"] = "broken"
+	default:
+		next := randomRegistry(r)
+		for k, v := range next {
+			if k != "app" && r.Intn(2) == 0 {
+				doc[k] = v
+			}
+		}
+	}
+	if _, ok := doc["app"].(map[string]any); !ok && r.Intn(2) == 0 {
+		doc["app"] = randomObject(r, 3)
+	}
+}
+
+// checkSources drives every watch source through a sequence of edits of a registry. Every
+// meow published must read like LoadReader of the same document, and a meow is published
+// exactly when the document differs from the last one loaded.
+func checkSources(t testing.TB, r *rand.Rand, steps int) {
+	t.Helper()
+	var edits [][]byte
+	var docs []map[string]any
+	doc := randomRegistry(r)
+	for i := 0; i < steps; i++ {
+		if i > 0 {
+			next := make(map[string]any, len(doc))
+			for k, v := range doc {
+				next[k] = v
+			}
+			stressEdit(r, next)
+			doc = next
+		}
+		data, _ := json.Marshal(doc)
+		edits, docs = append(edits, data), append(docs, doc)
+	}
+	for _, sem := range stressSemantics {
+		for _, c := range stressSources {
+			name := c.name + "/" + sem.name
+			opts := append(append([]Option(nil), sem.opts...), c.opts...)
+			load, update := c.open(t, newOptions(opts))
+			update(docs[0], edits[0])
+			reg, err := NewRegistry(load)
+			if err != nil {
+				t.Fatalf("Error: %s: %s\n%s", name, err, edits[0])
+			}
+			published := 0
+			reg.Subscribe(func(old, new *Meow) { published++ })
+			loaded := edits[0]
+			for i, data := range edits {
+				update(docs[i], data)
+				before, want := published, published
+				expected, experr := LoadReader("app", bytes.NewReader(data), sem.opts...)
+				if experr == nil && !bytes.Equal(data, loaded) {
+					loaded, want = data, want+1
+				}
+				err := reg.Reload()
+				if (err == nil) != (experr == nil) || published != want {
+					t.Fatalf("Error: %s step %d: found `%v` and %d publishes, expected `%v` and %d\n%s",
+						name, i, err, published-before, experr, want-before, data)
+				}
+				if experr == nil {
+					checkReads(t, fmt.Sprintf("%s step %d %s", name, i, data), reg.Meow(), expected, stressPaths(expected.Value(), nil, nil))
+				}
+			}
+		}
+	}
+}
+
+func TestStressWatch(t *testing.T) {
+
+	n := 10
+	if testing.Short() {
+		n = 2
+	}
+	for seed := int64(0); seed < int64(n); seed++ {
+		checkSources(t, rand.New(rand.NewSource(seed)), 12)
+	}
+}
+
+func FuzzStress(f *testing.F) {
+	for seed := int64(0); seed < 8; seed++ {
+		f.Add(seed)
+	}
+	f.Fuzz(func(t *testing.T, seed int64) {
+		checkConfigs(t, randomRegistry(rand.New(rand.NewSource(seed))))
+	})
+}
+
+// FuzzLoadReader checks that the buffered, parallel, lazy and arena loads of any input agree
+// with the streaming load: they fail together, and otherwise read the same.
+func FuzzLoadReader(f *testing.F) {
+	f.Add([]byte(body))
+	f.Add([]byte(`{"app": {"": {"": false, "0": true}, "0": {"0": false}}}`))
+	f.Add([]byte("\xdf\xe9\xef\v\x14{&\"Crc\xb8\x92\x9fCCCCCC'"))
+	f.Add([]byte("\xbb\xff\xff\xff\xff\xff\xff\xff\xff\x61a\x01"))
+	for seed := int64(0); seed < 4; seed++ {
+		data, _ := json.Marshal(randomRegistry(rand.New(rand.NewSource(seed))))
+		f.Add(data)
+	}
+	f.Fuzz(func(t *testing.T, data []byte) {
+		expected, experr := LoadReader("app", bytes.NewReader(data))
+		for _, c := range stressConfigs[1:8] {
+			meow, err := LoadReader("app", bytes.NewReader(data), c.opts...)
+			if (err == nil) != (experr == nil) {
+				t.Fatalf("Error: %s %q: found `%v`, expected `%v`", c.name, data, err, experr)
+			}
+			if err == nil {
+				checkReads(t, c.name, meow, expected, stressPaths(expected.Value(), nil, nil))
+			}
+		}
+	})
+}
+
+// stressPool is a set of registries told apart by the value of their key "version".
+type stressPool struct {
+	docs     [][]byte
+	expected []*Meow
+	paths    [][][]string
+}
+
+func newStressPool(t testing.TB, n int) *stressPool {
+	p := new(stressPool)
+	r := rand.New(rand.NewSource(1))
+	for i := 0; i < n; i++ {
+		doc := randomRegistry(r)
+		doc["app"].(map[string]any)["version"] = float64(i)
+		data, _ := json.Marshal(doc)
+		expected, err := LoadReader("app", bytes.NewReader(data))
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		p.docs = append(p.docs, data)
+		p.expected = append(p.expected, expected)
+		p.paths = append(p.paths, stressPaths(expected.Value(), nil, nil))
+	}
+	return p
+}
+
+// registry returns a registry loading the registries of the pool in turn with opts.
+func (p *stressPool) registry(t testing.TB, opts []Option) *Registry {
+	var next atomic.Int64
+	reg, err := NewRegistry(func() (*Meow, error) {
+		return LoadReader("app", bytes.NewReader(p.docs[int(next.Add(1))%len(p.docs)]), opts...)
+	})
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	return reg
+}
+
+// TestStressReload reads meows from many goroutines while reloads are published, and checks
+// every read against the registry the meow was loaded from. Run it with -race.
+func TestStressReload(t *testing.T) {
+
+	pool := newStressPool(t, 8)
+	duration := 100 * time.Millisecond
+	if testing.Short() {
+		duration = 10 * time.Millisecond
+	}
+	for _, c := range stressConfigs[:10] {
+		t.Run(c.name, func(t *testing.T) {
+			reg := pool.registry(t, c.opts)
+			live := reg.Compile("version")
+			pinned := reg.Pin("version")
+			var published atomic.Int64
+			reg.Subscribe(func(old, new *Meow) {
+				Diff(old, new)
+				published.Add(1)
+			})
+
+			stop := make(chan struct{})
+			errs := make(chan error, 16)
+			var wg sync.WaitGroup
+			for g := 0; g < 8; g++ {
+				wg.Add(1)
+				go func(g int) {
+					defer wg.Done()
+					r := rand.New(rand.NewSource(int64(g)))
+					for {
+						select {
+						case <-stop:
+							return
+						default:
+						}
+						meow := reg.Meow()
+						v := meow.ValueInt("version")
+						paths := pool.paths[v]
+						p := paths[r.Intn(len(paths))]
+						if found, want := meow.Value(p...), pool.expected[v].Value(p...); !reflect.DeepEqual(found, want) {
+							errs <- fmt.Errorf("version %d: Value%v: found `%v`, expected `%v`", v, p, found, want)
+							return
+						}
+						if meow.Exists(p...) != pool.expected[v].Exists(p...) {
+							errs <- fmt.Errorf("version %d: Exists%v differs", v, p)
+							return
+						}
+						if k := live.Key(); k.ValueInt() != k.Meow().ValueInt("version") {
+							errs <- fmt.Errorf("live key of version %d read %d", k.Meow().ValueInt("version"), k.ValueInt())
+							return
+						}
+						if n := pinned.ValueInt(); n < 0 || n >= len(pool.docs) {
+							errs <- fmt.Errorf("pinned version %d", n)
+							return
+						}
+					}
+				}(g)
+			}
+			deadline := time.Now().Add(duration)
+			for time.Now().Before(deadline) {
+				if err := reg.Reload(); err != nil {
+					t.Fatalf("Error: %s", err)
+				}
+			}
+			close(stop)
+			wg.Wait()
+			close(errs)
+			for err := range errs {
+				t.Errorf("Error: %s", err)
+			}
+			if published.Load() == 0 {
+				t.Errorf("Error: nothing published")
+			}
+			if pinned.Key().Meow() != reg.Meow() {
+				t.Errorf("Error: pinned key does not follow the registry")
+			}
+		})
+	}
+}
+
+// BenchmarkStress measures the read throughput of every configuration with reads on all
+// cores while reloads are published continuously.
+func BenchmarkStress(b *testing.B) {
+	pool := newStressPool(b, 8)
+	for _, c := range stressConfigs[:10] {
+		b.Run(c.name, func(b *testing.B) {
+			reg := pool.registry(b, c.opts)
+			stop := make(chan struct{})
+			var reloads atomic.Int64
+			go func() {
+				for {
+					select {
+					case <-stop:
+						return
+					default:
+						reg.Reload()
+						reloads.Add(1)
+					}
+				}
+			}()
+			b.ReportAllocs()
+			b.ResetTimer()
+			b.RunParallel(func(pb *testing.PB) {
+				i := 0
+				for pb.Next() {
+					meow := reg.Meow()
+					paths := pool.paths[meow.ValueInt("version")]
+					p := paths[i%len(paths)]
+					_ = meow.Value(p...)
+					_ = meow.Exists(p...)
+					i++
+				}
+			})
+			b.StopTimer()
+			close(stop)
+			b.ReportMetric(float64(reloads.Load())/b.Elapsed().Seconds(), "reloads/s")
+		})
+	}
+}
@@ -0,0 +1,136 @@
+package meow
+
+import (
+	"encoding/json"
+	"strconv"
+	"time"
+)
+
+// Scalar lists the types Get and Lookup convert values to. Integers must be whole numbers in
+// the range of their type, durations strings accepted by time.ParseDuration.
+type Scalar interface {
+	string | bool | int | int64 | float64 | time.Duration
+}
+
+// Get returns the value of a sequence of keys converted to T, the zero value of T when the
+// value is not defined or cannot be converted.
+func Get[T Scalar](meow *Meow, key ...string) T {
+	v, _ := Lookup[T](meow, key...)
+	return v
+}
+
+// Lookup returns the value of a sequence of keys converted to T, and whether the value is
+// defined and converted. With WithIndex, the values are converted once at load time and
+// Lookup neither converts nor allocates; with WithNumbers, integers are parsed exactly
+// from the document instead of going through a float64.
+func Lookup[T Scalar](meow *Meow, key ...string) (T, bool) {
+	var v T
+	if len(key) == 0 {
+		return v, false
+	}
+	if meow.overlay != nil && meow.overlay.covers(key) {
+		value, ok := meow.lookup(key)
+		if !ok {
+			return v, false
+		}
+		s := newScalar(value)
+		return v, s.get(&v)
+	}
+	if meow.arena != nil {
+		n, ok := meow.arena.find(key)
+		if !ok {
+			return v, false
+		}
+		s := meow.arena.scalar(n)
+		return v, s.get(&v)
+	}
+	if meow.index != nil {
+		slot, ok := meow.index.slot(key)
+		return v, ok && meow.index.scalars[slot].get(&v)
+	}
+	value, ok := meow.lookup(key)
+	if !ok {
+		return v, false
+	}
+	s := newScalar(value)
+	return v, s.get(&v)
+}
+
+const (
+	scalarString = 1 << iota
+	scalarBool
+	scalarInt
+	scalarInt64
+	scalarFloat
+	scalarDuration
+)
+
+// scalar holds the conversions of a value to the Scalar types.
+type scalar struct {
+	kinds uint8
+	b     bool
+	str   string
+	i     int64
+	f     float64
+	d     time.Duration
+}
+
+func newScalar(v any) scalar {
+	var s scalar
+	switch v := v.(type) {
+	case string:
+		s.kinds, s.str = scalarString, v
+		// Most strings are not durations: skip the error ParseDuration would allocate.
+		if v == "" || v[0] != '+' && v[0] != '-' && v[0] != '.' && (v[0] < '0' || v[0] > '9') {
+			break
+		}
+		if d, err := time.ParseDuration(v); err == nil {
+			s.kinds |= scalarDuration
+			s.d = d
+		}
+	case bool:
+		s.kinds, s.b = scalarBool, v
+	case float64, json.Number:
+		s.f, _ = numberOf(v)
+		s.kinds = scalarFloat
+		if i, ok := bindInt(v, 64); ok {
+			s.kinds |= scalarInt64
+			s.i = i
+			if _, ok := bindInt(v, strconv.IntSize); ok {
+				s.kinds |= scalarInt
+			}
+		}
+	}
+	return s
+}
+
+// get stores the conversion to the type p points to.
+func (s *scalar) get(p any) bool {
+	switch p := p.(type) {
+	case *string:
+		*p = s.str
+		return s.kinds&scalarString != 0
+	case *bool:
+		*p = s.b
+		return s.kinds&scalarBool != 0
+	case *int:
+		if s.kinds&scalarInt == 0 {
+			return false
+		}
+		*p = int(s.i)
+	case *int64:
+		if s.kinds&scalarInt64 == 0 {
+			return false
+		}
+		*p = s.i
+	case *float64:
+		*p = s.f
+		return s.kinds&scalarFloat != 0
+	case *time.Duration:
+		*p = s.d
+		return s.kinds&scalarDuration != 0
+	default:
+		return false
+	}
+	return true
+}
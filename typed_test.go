@@ -0,0 +1,60 @@
+package meow
+
+import (
+	"encoding/json"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestTyped(t *testing.T) {
+
+	doc := `{"chess": {"s": "S", "b": true, "i": 42, "f": 1.5, "big": 9007199254740993,
+		"d": "1m30s", "db": {"pool": {"max": 10}}, "ints": [1, 2], "imap": {"a": 3}}}`
+	for _, opts := range [][]Option{nil, {WithIndex()}, {WithNumbers()}, {WithIndex(), WithNumbers()}} {
+		meow, err := LoadReader("chess", strings.NewReader(doc), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		if Get[string](meow, "s") != "S" || !Get[bool](meow, "b") || Get[int](meow, "i") != 42 ||
+			Get[float64](meow, "f") != 1.5 || Get[time.Duration](meow, "d") != 90*time.Second ||
+			Get[int64](meow, "db", "pool", "max") != 10 || Get[float64](meow, "i") != 42 {
+			t.Errorf("Error: wrong conversion with %d options\n\n%v", len(opts), meow.meow)
+		}
+		if _, ok := Lookup[int](meow, "f"); ok {
+			t.Errorf("Error: 1.5 converted to an int")
+		}
+		if _, ok := Lookup[string](meow, "i"); ok {
+			t.Errorf("Error: number converted to a string")
+		}
+		if _, ok := Lookup[int](meow, "none"); ok {
+			t.Errorf("Error: undefined key converted")
+		}
+		if _, ok := Lookup[int](meow); ok {
+			t.Errorf("Error: empty key converted")
+		}
+		if meow.ValueInt("i") != 42 || meow.ValueIntSlice("ints")[1] != 2 || meow.ValueIntMap("imap")["a"] != 3 {
+			t.Errorf("Error: typed helpers broken with %d options", len(opts))
+		}
+		if meow.index != nil {
+			allocs := testing.AllocsPerRun(100, func() {
+				_ = Get[int](meow, "db", "pool", "max")
+				_ = Get[string](meow, "s")
+			})
+			if allocs != 0 {
+				t.Errorf("Error: %v allocations per lookup", allocs)
+			}
+		}
+	}
+
+	meow, err := LoadReader("chess", strings.NewReader(doc), WithNumbers())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	if Get[int64](meow, "big") != 9007199254740993 {
+		t.Errorf("Error: found `%d`", Get[int64](meow, "big"))
+	}
+	if _, ok := meow.Value("i").(json.Number); !ok {
+		t.Errorf("Error: number not decoded as json.Number")
+	}
+}
@@ -0,0 +1,66 @@
+package meow
+
+import (
+	"encoding/binary"
+	"sync"
+	"sync/atomic"
+)
+
+const (
+	viewStringMap byte = iota
+	viewStringSlice
+	viewIntMap
+	viewIntSlice
+)
+
+// views memoises typed conversions of a meow. Readers load an immutable map without
+// locking; a miss converts the value and publishes a copy of the map with the new view.
+type views struct {
+	mu sync.Mutex
+	m  atomic.Pointer[map[string]any]
+}
+
+// view returns the conversion of the value at key, memoised when the meow has views.
+func view[T any](meow *Meow, kind byte, key []string, convert func(any) T) T {
+	var buf [128]byte
+	p := viewKey(buf[:0], kind, key)
+	if v, ok := meow.typed[string(p)]; ok {
+		return v.(T)
+	}
+	if meow.views == nil {
+		return convert(meow.Value(key...))
+	}
+	if m := meow.views.m.Load(); m != nil {
+		if v, ok := (*m)[string(p)]; ok {
+			return v.(T)
+		}
+	}
+	v := convert(meow.Value(key...))
+	meow.views.store(string(p), v)
+	return v
+}
+
+func (c *views) store(key string, v any) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	old := c.m.Load()
+	m := make(map[string]any, 1)
+	if old != nil {
+		m = make(map[string]any, len(*old)+1)
+		for k, v := range *old {
+			m[k] = v
+		}
+	}
+	m[key] = v
+	c.m.Store(&m)
+}
+
+// viewKey encodes a view kind and a sequence of keys unambiguously.
+func viewKey(p []byte, kind byte, key []string) []byte {
+	p = append(p, kind)
+	for _, k := range key {
+		p = binary.AppendUvarint(p, uint64(len(k)))
+		p = append(p, k...)
+	}
+	return p
+}
@@ -0,0 +1,53 @@
+package meow
+
+import (
+	"reflect"
+	"strings"
+	"sync"
+	"testing"
+)
+
+func TestViews(t *testing.T) {
+
+	plain, err := LoadReader("chess", strings.NewReader(body))
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	meow, err := LoadReader("chess", strings.NewReader(body), WithViews())
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+
+	var wg sync.WaitGroup
+	for i := 0; i < 4; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			_ = meow.ValueStringMap("map-string")
+			_ = meow.ValueIntSlice("slice-int")
+		}()
+	}
+	wg.Wait()
+
+	if !reflect.DeepEqual(meow.ValueStringMap("map-string"), plain.ValueStringMap("map-string")) ||
+		!reflect.DeepEqual(meow.ValueStringSlice("slice-string"), plain.ValueStringSlice("slice-string")) ||
+		!reflect.DeepEqual(meow.ValueIntSlice("slice-int"), plain.ValueIntSlice("slice-int")) ||
+		meow.ValueIntMap("map-int") != nil || meow.ValueIntMap("none") != nil {
+		t.Errorf("Error: views differ from conversions\n\n%v", meow.meow)
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		_ = meow.ValueStringMap("map-string")
+		_ = meow.ValueStringSlice("slice-string")
+		_ = meow.ValueIntSlice("slice-int")
+		_ = meow.ValueIntMap("map-int")
+	})
+	if allocs != 0 {
+		t.Errorf("Error: %v allocations per cached call", allocs)
+	}
+
+	k := meow.Compile("slice-string")
+	if !reflect.DeepEqual(k.ValueStringSlice(), []string{"a", "b"}) {
+		t.Errorf("Error: found `%v`", k.ValueStringSlice())
+	}
+}
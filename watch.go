@@ -0,0 +1,267 @@
+package meow
+
+import (
+	"fmt"
+	"hash/maphash"
+	"os"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// Watcher keeps a Registry in sync with a meow file. Changes are picked up from file system
+// notifications where available and by polling the size and modification time of the file
+// otherwise; the file is only loaded again when its content actually changed.
+type Watcher struct {
+	registry *Registry
+	stop     chan struct{}
+	done     chan struct{}
+	once     sync.Once
+	// notified, when set, is called on every file system notification before the reload.
+	notified func()
+
+	mu  sync.Mutex
+	err error
+}
+
+// WatchFile loads the meow for an application appid from a given file and watches the
+// file for changes. The file is polled every interval, 1s when interval is not positive.
+func WatchFile(appid string, meowFile string, interval time.Duration, opts ...Option) (*Watcher, error) {
+	if appid == "" {
+		return nil, fmt.Errorf("meow identification is empty")
+	}
+	if meowFile == "" {
+		return nil, fmt.Errorf("no meow file specified")
+	}
+	if interval <= 0 {
+		interval = time.Second
+	}
+	src := &fileSource{appid: appid, meowFile: meowFile, o: newOptions(opts), seed: maphash.MakeSeed()}
+	reg, err := NewRegistry(src.load)
+	if err != nil {
+		return nil, err
+	}
+	events, cancel := notify(meowFile)
+	return startWatcher(reg, src.o, events, cancel, interval, src.notify), nil
+}
+
+// startWatcher runs a Watcher of reg reloading on events and every interval; notified is
+// called on every event before the reload. The registry follows the overlay of the options
+// while watching, so the overrides set meanwhile reach its readers, see Registry.Overlay.
+func startWatcher(reg *Registry, o *options, events <-chan struct{}, cancel func(), interval time.Duration, notified func()) *Watcher {
+	w := &Watcher{registry: reg, stop: make(chan struct{}), done: make(chan struct{}), notified: notified}
+	if o.overlay != nil {
+		unfollow := reg.Overlay(o.overlay)
+		stop := cancel
+		cancel = func() {
+			stop()
+			unfollow()
+		}
+	}
+	go w.run(events, cancel, interval)
+	return w
+}
+
+// Registry returns the registry kept in sync with the file.
+func (w *Watcher) Registry() *Registry {
+	return w.registry
+}
+
+// Err returns the error of the last reload, nil when it succeeded.
+func (w *Watcher) Err() error {
+	w.mu.Lock()
+	defer w.mu.Unlock()
+	return w.err
+}
+
+// Close stops watching the file. The registry keeps its current meow. Close may be called
+// more than once.
+func (w *Watcher) Close() {
+	w.once.Do(func() { close(w.stop) })
+	<-w.done
+}
+
+func (w *Watcher) run(events <-chan struct{}, cancel func(), interval time.Duration) {
+	defer close(w.done)
+	defer cancel()
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-w.stop:
+			return
+		case _, ok := <-events:
+			if !ok {
+				events = nil
+				continue
+			}
+			if w.notified != nil {
+				w.notified()
+			}
+		case <-ticker.C:
+		}
+		err := w.registry.Reload()
+		w.mu.Lock()
+		w.err = err
+		w.mu.Unlock()
+	}
+}
+
+// fileSource loads a meow file incrementally. It remembers the content hash of every
+// top-level value and the layers decoded from it: only the values that changed are decoded
+// again, and only the keys contributed by changed layers are merged again. With WithArena
+// the merged map is not kept, as it would hold on to what the arena saves: the layers are
+// merged again on every change.
+type fileSource struct {
+	appid    string
+	meowFile string
+	o        *options
+	seed     maphash.Seed
+	notified atomic.Bool
+
+	size   int64
+	mtime  time.Time
+	sum    uint64
+	layers map[string]sourceLayer
+	merged map[string]any
+}
+
+type sourceLayer struct {
+	sum   uint64
+	layer layer
+	merge bool
+}
+
+// notify makes the next load read the file whatever its size and modification time, which
+// may not change when the file is rewritten within the resolution of the file system clock.
+func (s *fileSource) notify() {
+	s.notified.Store(true)
+}
+
+// load returns the meow of the file, or nil when the content did not change. The size and
+// modification time are only remembered once the content was built, so that a file that
+// failed to build is read again on the next poll.
+func (s *fileSource) load() (*Meow, error) {
+	fi, err := os.Stat(s.meowFile)
+	if err != nil {
+		return nil, fmt.Errorf("error at opening meow file `%s`: %s", s.meowFile, err)
+	}
+	notified := s.notified.Swap(false)
+	if s.layers != nil && !notified && fi.Size() == s.size && fi.ModTime().Equal(s.mtime) {
+		return nil, nil
+	}
+	data, err := os.ReadFile(s.meowFile)
+	if err != nil {
+		return nil, fmt.Errorf("error at opening meow file `%s`: %s", s.meowFile, err)
+	}
+	sum := maphash.Bytes(s.seed, data)
+	if s.layers != nil && sum == s.sum {
+		s.size, s.mtime = fi.Size(), fi.ModTime()
+		return nil, nil
+	}
+	merged, err := s.build(data)
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow file `%s`: %s", s.meowFile, err)
+	}
+	meow, err := newMeow(s.appid, merged, s.o)
+	if err != nil {
+		return nil, fmt.Errorf("error at handling meow file `%s`: %s", s.meowFile, err)
+	}
+	s.size, s.mtime, s.sum = fi.Size(), fi.ModTime(), sum
+	meow.meowFile = s.meowFile
+	return meow, nil
+}
+
+func (s *fileSource) build(data []byte) (map[string]any, error) {
+	o := s.o.forDocument(data)
+	spans, err := o.split(data)
+	if err != nil {
+		return nil, err
+	}
+	if err := validJSON(data, o); err != nil {
+		return nil, err
+	}
+
+	layers := make(map[string]sourceLayer, len(spans))
+	set := layerSet{appid: s.appid}
+	var changed []string
+	rebuild := s.merged == nil
+	for _, sp := range spans {
+		if _, ok := layers[sp.key]; ok {
+			rebuild = true
+		}
+		raw := data[sp.start:sp.end]
+		sum := maphash.Bytes(s.seed, raw)
+		l, ok := s.layers[sp.key]
+		if !ok || l.sum != sum {
+			mw, scored, err := decodeSpan(raw, sp.key == s.appid, o)
+			if err != nil {
+				return nil, fmt.Errorf("does not contain a valid JSON object: %s", err)
+			}
+			mw.name = sp.key
+			l = sourceLayer{sum: sum, layer: mw, merge: scored || sp.key == s.appid}
+			changed = append(changed, sp.key)
+		}
+		layers[sp.key] = l
+		if sp.key != s.appid {
+			set.layer(sp.key, l.layer, l.merge)
+		}
+	}
+	for k := range s.layers {
+		if _, ok := layers[k]; !ok {
+			changed = append(changed, k)
+		}
+	}
+
+	app, ok := layers[s.appid]
+	if !ok {
+		return nil, fmt.Errorf("does not contain `%s`", s.appid)
+	}
+	if app.layer.value == nil {
+		return nil, fmt.Errorf("`%s` is not a JSON object", s.appid)
+	}
+	mews := orderLayers(s.appid, set.layers(), app.layer.value)
+
+	var merged map[string]any
+	if rebuild {
+		merged = mergeLayers(mews, s.o.deep)
+	} else {
+		objs := make([]map[string]any, len(mews))
+		for i, mw := range mews {
+			objs[len(mews)-1-i] = mw.value
+		}
+		merged = make(map[string]any, len(s.merged))
+		for k, v := range s.merged {
+			merged[k] = v
+		}
+		for _, name := range changed {
+			for _, l := range []sourceLayer{s.layers[name], layers[name]} {
+				if !l.merge {
+					continue
+				}
+				for k := range l.layer.value {
+					remerge(merged, objs, k, s.o.deep)
+				}
+			}
+		}
+	}
+	s.layers = layers
+	if !s.o.arena {
+		s.merged = merged
+	}
+	return merged, nil
+}
+
+// remerge sets key k of merged from layer objects given from the highest precedence down.
+func remerge(merged map[string]any, objs []map[string]any, k string, deep bool) {
+	for i, obj := range objs {
+		if v, ok := obj[k]; ok {
+			if deep {
+				v = mergeValue(objs[i+1:], k, v)
+			}
+			merged[k] = v
+			return
+		}
+	}
+	delete(merged, k)
+}
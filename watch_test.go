@@ -0,0 +1,116 @@
+package meow
+
+import (
+	"hash/maphash"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestFileSource(t *testing.T) {
+	testFileSource(t)
+	testFileSource(t, WithDeepMerge())
+	testFileSource(t, WithArena())
+	testFileSource(t, WithArena(), WithDeepMerge())
+}
+
+func testFileSource(t *testing.T, opts ...Option) {
+
+	meowFile := filepath.Join(t.TempDir(), "meow.json")
+	src := &fileSource{appid: "chess", meowFile: meowFile, o: newOptions(opts), seed: maphash.MakeSeed()}
+	bodies := []string{
+		body,
+		strings.Replace(body, `"key-test1": "branch1 general3"`, `"key-test1": "changed", "new": 1`, 1),
+		strings.Replace(body, `"meow-score": 11`, `"meow-score": 1`, 1),
+		strings.Replace(body, `"meow-score": 10,`, ``, 1),
+		strings.Replace(body, `"meow-score": 9,`, `"meow-score": 9, "g1": {"b1": "B"},`, 1),
+		`{"chess": {"a": 1}}`,
+	}
+	for i, b := range bodies {
+		if err := os.WriteFile(meowFile, []byte(b), 0o600); err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		os.Chtimes(meowFile, time.Now(), time.Now().Add(time.Duration(i)*time.Second))
+		meow, err := src.load()
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		expected, err := LoadReader("chess", strings.NewReader(b), opts...)
+		if err != nil {
+			t.Fatalf("Error: %s", err)
+		}
+		if !reflect.DeepEqual(meow.root(), expected.root()) {
+			t.Errorf("Error: body %d: found\n%v\nexpected\n%v", i, meow.root(), expected.root())
+		}
+		if src.o.arena && src.merged != nil {
+			t.Errorf("Error: body %d: merged map kept with an arena", i)
+		}
+		if i == 0 {
+			continue
+		}
+
+		os.Chtimes(meowFile, time.Now(), time.Now().Add(time.Hour+time.Duration(i)*time.Second))
+		if meow, err := src.load(); meow != nil || err != nil {
+			t.Errorf("Error: body %d: reloaded unchanged content", i)
+		}
+	}
+
+	// A rewrite keeping the size and modification time is only seen when notified.
+	fi, _ := os.Stat(meowFile)
+	os.WriteFile(meowFile, []byte(`{"chess": {"a": 2}}`), 0o600)
+	os.Chtimes(meowFile, fi.ModTime(), fi.ModTime())
+	if meow, err := src.load(); meow != nil || err != nil {
+		t.Errorf("Error: reloaded an unchanged size and modification time")
+	}
+	src.notify()
+	if meow, err := src.load(); err != nil || meow == nil || meow.ValueInt("a") != 2 {
+		t.Errorf("Error: notified rewrite not reloaded: `%v` `%v`", meow, err)
+	}
+
+	// A broken file fails every load until it is fixed.
+	os.WriteFile(meowFile, []byte(`{"chess": 1}`), 0o600)
+	os.Chtimes(meowFile, time.Now(), time.Now().Add(2*time.Hour))
+	for i := 0; i < 2; i++ {
+		if _, err := src.load(); err == nil {
+			t.Errorf("Error: %d: no error for a broken file", i)
+		}
+	}
+	os.WriteFile(meowFile, []byte(`{"chess": {"a": 3}}`), 0o600)
+	if meow, err := src.load(); err != nil || meow == nil || meow.ValueInt("a") != 3 {
+		t.Errorf("Error: fixed file not reloaded: `%v` `%v`", meow, err)
+	}
+}
+
+func TestWatchFile(t *testing.T) {
+
+	meowFile := filepath.Join(t.TempDir(), "meow.json")
+	if err := os.WriteFile(meowFile, []byte(`{"chess": {"n": 1}}`), 0o600); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	w, err := WatchFile("chess", meowFile, 10*time.Millisecond)
+	if err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	defer w.Close()
+
+	published := make(chan *Meow, 4)
+	w.Registry().Subscribe(func(old, new *Meow) { published <- new })
+	if err := os.WriteFile(meowFile, []byte(`{"chess": {"n": 2}}`), 0o600); err != nil {
+		t.Fatalf("Error: %s", err)
+	}
+	select {
+	case meow := <-published:
+		if meow.ValueInt("n") != 2 {
+			t.Errorf("Error: found `%d`", meow.ValueInt("n"))
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatalf("Error: change not picked up")
+	}
+	if w.Err() != nil {
+		t.Errorf("Error: %s", w.Err())
+	}
+	w.Close()
+}